@@ -517,6 +517,13 @@ extern "C" {
 
 #define GLFW_KEY_LAST               GLFW_KEY_MENU
 
+/*! @brief The number of words in a keyboard state snapshot.
+ *
+ *  The number of `uint64_t` elements needed to hold the state of every key
+ *  token up to @ref GLFW_KEY_LAST, as retrieved by @ref glfwGetKeyboardState.
+ */
+#define GLFW_KEYBOARD_STATE_WORDS   ((GLFW_KEY_LAST + 64) / 64)
+
 /*! @} */
 
 /*! @defgroup mods Modifier key flags
@@ -927,6 +934,12 @@ extern "C" {
  *  [window attribute](@ref GLFW_MOUSE_PASSTHROUGH_attrib).
  */
 #define GLFW_MOUSE_PASSTHROUGH      0x0002000D
+/*! @brief Software framebuffer window hint and attribute
+ *
+ *  Software framebuffer [window hint](@ref GLFW_SOFTWARE_FRAMEBUFFER_hint) or
+ *  [window attribute](@ref GLFW_SOFTWARE_FRAMEBUFFER_attrib).
+ */
+#define GLFW_SOFTWARE_FRAMEBUFFER   0x0002000E
 
 /*! @brief Framebuffer bit depth hint.
  *
@@ -1106,6 +1119,10 @@ extern "C" {
  */
 #define GLFW_X11_INSTANCE_NAME      0x00024002
 #define GLFW_WIN32_KEYBOARD_MENU    0x00025001
+/*! @brief Null specific
+ *  [window hint](@ref GLFW_NULL_FRAME_EXPORT_hint).
+ */
+#define GLFW_NULL_FRAME_EXPORT      0x00026001
 /*! @} */
 
 #define GLFW_NO_API                          0
@@ -1125,6 +1142,7 @@ extern "C" {
 #define GLFW_STICKY_MOUSE_BUTTONS   0x00033003
 #define GLFW_LOCK_KEY_MODS          0x00033004
 #define GLFW_RAW_MOUSE_MOTION       0x00033005
+#define GLFW_RAW_MOUSE_MOTION_EVENTS 0x00033006
 
 #define GLFW_CURSOR_NORMAL          0x00034001
 #define GLFW_CURSOR_HIDDEN          0x00034002
@@ -1287,6 +1305,16 @@ extern "C" {
  *  X11 specific [init hint](@ref GLFW_X11_XCB_VULKAN_SURFACE_hint).
  */
 #define GLFW_X11_XCB_VULKAN_SURFACE 0x00052001
+/*! @brief X11 specific init hint.
+ *
+ *  X11 specific [init hint](@ref GLFW_X11_MOTION_COMPRESSION_hint).
+ */
+#define GLFW_X11_MOTION_COMPRESSION 0x00052002
+/*! @brief X11 specific init hint.
+ *
+ *  X11 specific [init hint](@ref GLFW_X11_SHARED_MEMORY_hint).
+ */
+#define GLFW_X11_SHARED_MEMORY      0x00052003
 /*! @} */
 
 /*! @addtogroup init
@@ -1303,6 +1331,26 @@ extern "C" {
 #define GLFW_PLATFORM_NULL          0x00060005
 /*! @} */
 
+/*! @addtogroup window
+ *  @{ */
+/*! @brief The file descriptor is readable.
+ *
+ *  The watched file descriptor is readable.  See @ref events_fd.
+ */
+#define GLFW_FD_READ                0x0001
+/*! @brief The file descriptor is writable.
+ *
+ *  The watched file descriptor is writable.  See @ref events_fd.
+ */
+#define GLFW_FD_WRITE               0x0002
+/*! @brief An error or hang-up occurred on the file descriptor.
+ *
+ *  An error or hang-up occurred on the watched file descriptor.  This is
+ *  reported whether or not it was requested.  See @ref events_fd.
+ */
+#define GLFW_FD_ERROR               0x0004
+/*! @} */
+
 #define GLFW_DONT_CARE              -1
 
 
@@ -1374,6 +1422,18 @@ typedef struct GLFWwindow GLFWwindow;
  */
 typedef struct GLFWcursor GLFWcursor;
 
+/*! @brief Opaque timer object.
+ *
+ *  Opaque timer object.
+ *
+ *  @see @ref time_timers
+ *
+ *  @since Added in version 3.4.
+ *
+ *  @ingroup input
+ */
+typedef struct GLFWtimer GLFWtimer;
+
 /*! @brief The function pointer type for memory allocation callbacks.
  *
  *  This is the function pointer type for memory allocation callbacks.  A memory
@@ -1878,6 +1938,29 @@ typedef void (* GLFWcharfun)(GLFWwindow* window, unsigned int codepoint);
  */
 typedef void (* GLFWcharmodsfun)(GLFWwindow* window, unsigned int codepoint, int mods);
 
+/*! @brief The function pointer type for text input callbacks.
+ *
+ *  This is the function pointer type for text input callbacks.  A text input
+ *  callback function has the following signature:
+ *  @code
+ *  void function_name(GLFWwindow* window, const char* text)
+ *  @endcode
+ *
+ *  @param[in] window The window that received the event.
+ *  @param[in] text The UTF-8 encoded text that was input.
+ *
+ *  @pointer_lifetime The text string is valid until the callback function
+ *  returns.
+ *
+ *  @sa @ref input_char
+ *  @sa @ref glfwSetTextCallback
+ *
+ *  @since Added in version 3.4.
+ *
+ *  @ingroup input
+ */
+typedef void (* GLFWtextfun)(GLFWwindow* window, const char* text);
+
 /*! @brief The function pointer type for path drop callbacks.
  *
  *  This is the function pointer type for path drop callbacks.  A path drop
@@ -1944,6 +2027,66 @@ typedef void (* GLFWmonitorfun)(GLFWmonitor* monitor, int event);
  */
 typedef void (* GLFWjoystickfun)(int jid, int event);
 
+/*! @brief The function pointer type for user event callbacks.
+ *
+ *  This is the function pointer type for user event callbacks.  A user event
+ *  callback function has the following signature:
+ *  @code
+ *  void function_name(void* payload, int tag)
+ *  @endcode
+ *
+ *  @param[in] payload The pointer passed to @ref glfwPostUserEvent.
+ *  @param[in] tag The tag passed to @ref glfwPostUserEvent.
+ *
+ *  @sa @ref events_user
+ *  @sa @ref glfwSetUserEventCallback
+ *
+ *  @since Added in version 3.4.
+ *
+ *  @ingroup window
+ */
+typedef void (* GLFWusereventfun)(void* payload, int tag);
+
+/*! @brief The function pointer type for file descriptor watch callbacks.
+ *
+ *  This is the function pointer type for file descriptor watch callbacks.
+ *  A file descriptor watch callback function has the following signature:
+ *  @code
+ *  void function_name(int fd, int events)
+ *  @endcode
+ *
+ *  @param[in] fd The file descriptor that is ready.
+ *  @param[in] events A bit field of `GLFW_FD_READ`, `GLFW_FD_WRITE` and
+ *  `GLFW_FD_ERROR` describing how it is ready.
+ *
+ *  @sa @ref events_fd
+ *  @sa @ref glfwWatchFd
+ *
+ *  @since Added in version 3.4.
+ *
+ *  @ingroup window
+ */
+typedef void (* GLFWfdfun)(int fd, int events);
+
+/*! @brief The function pointer type for timer callbacks.
+ *
+ *  This is the function pointer type for timer callbacks.  A timer callback
+ *  function has the following signature:
+ *  @code
+ *  void function_name(GLFWtimer* timer)
+ *  @endcode
+ *
+ *  @param[in] timer The timer that expired.
+ *
+ *  @sa @ref time_timers
+ *  @sa @ref glfwCreateTimer
+ *
+ *  @since Added in version 3.4.
+ *
+ *  @ingroup input
+ */
+typedef void (* GLFWtimerfun)(GLFWtimer* timer);
+
 /*! @brief Video mode type.
  *
  *  This describes a single video mode.
@@ -2033,6 +2176,33 @@ typedef struct GLFWimage
     unsigned char* pixels;
 } GLFWimage;
 
+/*! @brief Rectangle.
+ *
+ *  This describes a rectangular area of a window.
+ *
+ *  @sa @ref window_refresh
+ *  @sa @ref glfwGetWindowDamage
+ *
+ *  @since Added in version 3.4.
+ *
+ *  @ingroup window
+ */
+typedef struct GLFWrect
+{
+    /*! The x-coordinate of the left edge of this rectangle.
+     */
+    int x;
+    /*! The y-coordinate of the top edge of this rectangle.
+     */
+    int y;
+    /*! The width of this rectangle.
+     */
+    int width;
+    /*! The height of this rectangle.
+     */
+    int height;
+} GLFWrect;
+
 /*! @brief Gamepad input state
  *
  *  This describes the input state of a gamepad.
@@ -2073,6 +2243,28 @@ typedef struct GLFWallocator
     void* user;
 } GLFWallocator;
 
+/*! @brief Module load time.
+ *
+ *  This describes how long it took to load a library module, such as an X11
+ *  extension library or a context creation API, and to query what it supports.
+ *
+ *  @sa @ref init_module_times
+ *  @sa @ref glfwGetModuleLoadTimes
+ *
+ *  @since Added in version 3.4.
+ *
+ *  @ingroup init
+ */
+typedef struct GLFWmoduletime
+{
+    /*! The name of the module, for example `"Xrandr"` or `"EGL"`.
+     */
+    const char* name;
+    /*! The time, in seconds, spent loading and querying the module.
+     */
+    double seconds;
+} GLFWmoduletime;
+
 
 /*************************************************************************
  * GLFW API functions
@@ -2455,6 +2647,41 @@ GLFWAPI int glfwGetPlatform(void);
  */
 GLFWAPI int glfwPlatformSupported(int platform);
 
+/*! @brief Returns how long each loaded library module took to load.
+ *
+ *  This function returns an array describing the library modules that have
+ *  been loaded since initialization, in the order they were loaded.  Modules
+ *  needed by every application are loaded by @ref glfwInit, while optional ones
+ *  are loaded by the first function that needs them, so the array may grow
+ *  during the lifetime of the library.
+ *
+ *  Optional X11 extension libraries are listed even if they were not found, as
+ *  looking for them also takes time.
+ *
+ *  @param[out] count Where to store the number of elements in the returned
+ *  array.  This is set to zero if an error occurred.
+ *  @return An array of module load times, or `NULL` if an
+ *  [error](@ref error_handling) occurred.
+ *
+ *  @errors Possible errors include @ref GLFW_NOT_INITIALIZED.
+ *
+ *  @remark Module load times are currently only recorded on X11 and for the
+ *  GLX, EGL, OSMesa and Vulkan loaders.
+ *
+ *  @pointer_lifetime The returned array is allocated and freed by GLFW.  You
+ *  should not free it yourself.  It is guaranteed to be valid only until the
+ *  library is terminated.  Elements already in the array are never changed.
+ *
+ *  @thread_safety This function must only be called from the main thread.
+ *
+ *  @sa @ref init_module_times
+ *
+ *  @since Added in version 3.4.
+ *
+ *  @ingroup init
+ */
+GLFWAPI const GLFWmoduletime* glfwGetModuleLoadTimes(int* count);
+
 /*! @brief Returns the currently connected monitors.
  *
  *  This function returns an array of handles for all currently connected
@@ -3059,8 +3286,13 @@ GLFWAPI void glfwWindowHintString(int hint, const char* value);
  *
  *  @errors Possible errors include @ref GLFW_NOT_INITIALIZED, @ref
  *  GLFW_INVALID_ENUM, @ref GLFW_INVALID_VALUE, @ref GLFW_API_UNAVAILABLE, @ref
- *  GLFW_VERSION_UNAVAILABLE, @ref GLFW_FORMAT_UNAVAILABLE and @ref
- *  GLFW_PLATFORM_ERROR.
+ *  GLFW_VERSION_UNAVAILABLE, @ref GLFW_FORMAT_UNAVAILABLE, @ref
+ *  GLFW_FEATURE_UNAVAILABLE and @ref GLFW_PLATFORM_ERROR.
+ *
+ *  @remark Software framebuffers are only supported on the null platform.
+ *  Elsewhere, window creation with the
+ *  [GLFW_SOFTWARE_FRAMEBUFFER](@ref GLFW_SOFTWARE_FRAMEBUFFER_hint) hint fails
+ *  with @ref GLFW_FEATURE_UNAVAILABLE.
  *
  *  @remark @win32 Window creation will fail if the Microsoft GDI software
  *  OpenGL implementation is the only one available.
@@ -3536,6 +3768,108 @@ GLFWAPI void glfwSetWindowSize(GLFWwindow* window, int width, int height);
  */
 GLFWAPI void glfwGetFramebufferSize(GLFWwindow* window, int* width, int* height);
 
+/*! @brief Returns the software framebuffer of the specified window.
+ *
+ *  This function returns the back buffer of the software framebuffer of the
+ *  specified window, for drawing into with the CPU.  The window must have been
+ *  created with the [GLFW_SOFTWARE_FRAMEBUFFER](@ref GLFW_SOFTWARE_FRAMEBUFFER_hint)
+ *  window hint.
+ *
+ *  The pixels are 32-bit RGBA with eight bits per channel, in the same order
+ *  as @ref GLFWimage, arranged in rows from the top down.  The buffer has the
+ *  size of the framebuffer, see @ref glfwGetFramebufferSize.  Rows are
+ *  `stride` bytes apart, which may be more than four times the width.
+ *
+ *  Call @ref glfwSwapBuffers to make the back buffer the front buffer.  The
+ *  contents of the new back buffer are what was last drawn into it, two swaps
+ *  ago.  The contents are undefined after the framebuffer has been resized.
+ *
+ *  @param[in] window The window whose software framebuffer to return.
+ *  @param[out] stride Where to store the distance, in bytes, between the start
+ *  of consecutive rows, or `NULL`.
+ *  @return The back buffer of the window, or `NULL` if an
+ *  [error](@ref error_handling) occurred.
+ *
+ *  @errors Possible errors include @ref GLFW_NOT_INITIALIZED, @ref
+ *  GLFW_INVALID_VALUE, @ref GLFW_OUT_OF_MEMORY and @ref
+ *  GLFW_FEATURE_UNAVAILABLE.
+ *
+ *  @remark Software framebuffers are only supported on the null platform.
+ *  Elsewhere, window creation with the
+ *  [GLFW_SOFTWARE_FRAMEBUFFER](@ref GLFW_SOFTWARE_FRAMEBUFFER_hint) hint fails
+ *  with @ref GLFW_FEATURE_UNAVAILABLE.
+ *
+ *  @pointer_lifetime The returned buffer is allocated and freed by GLFW.  You
+ *  should not free it yourself.  It is valid until the next call to @ref
+ *  glfwSwapBuffers, until the framebuffer is resized or until the window is
+ *  destroyed.
+ *
+ *  @thread_safety This function must only be called from the main thread.
+ *
+ *  @sa @ref window_software
+ *  @sa @ref glfwSwapBuffers
+ *
+ *  @since Added in version 3.4.
+ *
+ *  @ingroup window
+ */
+GLFWAPI unsigned char* glfwGetWindowPixels(GLFWwindow* window, int* stride);
+
+/*! @brief Presents pixels in the content area of the specified window.
+ *
+ *  This function copies pixels rendered by the CPU to the content area of the
+ *  specified window, for windows without an OpenGL or OpenGL ES context.
+ *
+ *  The pixels are 32-bit RGBA with eight bits per channel, in the same order
+ *  as @ref GLFWimage, arranged in rows from the top down.  The pixel array
+ *  must cover the whole framebuffer, see @ref glfwGetFramebufferSize, but only
+ *  the pixels inside the specified rectangle are updated.  This lets you
+ *  present only the parts of the window that have changed.
+ *
+ *  The alpha channel is only used by windows with a
+ *  [transparent framebuffer](@ref window_transparency).  The pixels are not
+ *  premultiplied by alpha, GLFW does that if the window system requires it.
+ *
+ *  @param[in] window The window to present to.
+ *  @param[in] pixels The pixels to present.
+ *  @param[in] stride The distance, in bytes, between the start of consecutive
+ *  rows of pixels.  This must be at least four times the framebuffer width.
+ *  @param[in] rect The rectangle, in pixels relative to the upper-left corner
+ *  of the framebuffer, to update, or `NULL` to update the whole framebuffer.
+ *
+ *  @errors Possible errors include @ref GLFW_NOT_INITIALIZED, @ref
+ *  GLFW_INVALID_VALUE, @ref GLFW_FEATURE_UNAVAILABLE and @ref
+ *  GLFW_PLATFORM_ERROR.
+ *
+ *  @remark @x11 This uses the MIT-SHM extension when it is available and
+ *  falls back to `XPutImage` otherwise.  The
+ *  [GLFW_X11_SHARED_MEMORY](@ref GLFW_X11_SHARED_MEMORY_hint) init hint can
+ *  disable the use of MIT-SHM.  The window visual must have 32 bits per pixel
+ *  with eight bits per color channel.
+ *
+ *  @remark @wayland The pixels are copied into `wl_shm` buffers that are
+ *  reused once the compositor releases them.  This function does nothing
+ *  while the window is hidden.
+ *
+ *  @remark @win32 @macos Software presentation is not yet supported and this
+ *  function emits @ref GLFW_FEATURE_UNAVAILABLE.
+ *
+ *  @remark The null platform publishes the pixels to the
+ *  [frame export](@ref GLFW_NULL_FRAME_EXPORT_hint) ring of the window, if
+ *  any.
+ *
+ *  @pointer_lifetime The pixels are copied before this function returns.
+ *
+ *  @thread_safety This function must only be called from the main thread.
+ *
+ *  @sa @ref window_software
+ *
+ *  @since Added in version 3.4.
+ *
+ *  @ingroup window
+ */
+GLFWAPI void glfwPresentPixels(GLFWwindow* window, const unsigned char* pixels, int stride, const GLFWrect* rect);
+
 /*! @brief Retrieves the size of the frame of the window.
  *
  *  This function retrieves the size, in screen coordinates, of each edge of the
@@ -4208,6 +4542,42 @@ GLFWAPI GLFWwindowclosefun glfwSetWindowCloseCallback(GLFWwindow* window, GLFWwi
  */
 GLFWAPI GLFWwindowrefreshfun glfwSetWindowRefreshCallback(GLFWwindow* window, GLFWwindowrefreshfun callback);
 
+/*! @brief Returns the damaged areas of the specified window.
+ *
+ *  This function returns the areas of the content area of the specified window
+ *  that were damaged and caused the most recent call to its refresh callback.
+ *  The rectangles are in screen coordinates relative to the upper-left corner
+ *  of the content area and may overlap.
+ *
+ *  All damage received for a window during a single call to @ref
+ *  glfwPollEvents, @ref glfwWaitEvents or @ref glfwWaitEventsTimeout is
+ *  combined into a single refresh callback.  Platforms that do not report
+ *  which areas were damaged report the whole content area.
+ *
+ *  @param[in] window The window to query.
+ *  @param[out] count Where to store the number of rectangles in the returned
+ *  array.  This is set to zero if the window has not been damaged or an
+ *  [error](@ref error_handling) occurred.
+ *  @return An array of rectangles, or `NULL` if an [error](@ref error_handling)
+ *  occurred.
+ *
+ *  @errors Possible errors include @ref GLFW_NOT_INITIALIZED.
+ *
+ *  @pointer_lifetime The returned array is allocated and freed by GLFW.  You
+ *  should not free it yourself.  It is guaranteed to be valid only until the
+ *  next refresh of the window or until the window is destroyed.
+ *
+ *  @thread_safety This function must only be called from the main thread.
+ *
+ *  @sa @ref window_refresh
+ *  @sa @ref glfwSetWindowRefreshCallback
+ *
+ *  @since Added in version 3.4.
+ *
+ *  @ingroup window
+ */
+GLFWAPI const GLFWrect* glfwGetWindowDamage(GLFWwindow* window, int* count);
+
 /*! @brief Sets the focus callback for the specified window.
  *
  *  This function sets the focus callback of the specified window, which is
@@ -4516,17 +4886,199 @@ GLFWAPI void glfwWaitEventsTimeout(double timeout);
  */
 GLFWAPI void glfwPostEmptyEvent(void);
 
+/*! @brief Returns a file descriptor that becomes readable when events are
+ *  ready.
+ *
+ *  This function returns a single file descriptor that becomes readable when
+ *  there are events for GLFW to process, for embedding GLFW in an existing
+ *  `poll`, `epoll` or `io_uring` event loop instead of blocking in @ref
+ *  glfwWaitEvents.  It covers window system events, posted empty and user
+ *  events, joystick connections, key repeat, GLFW timers and watched file
+ *  descriptors.
+ *
+ *  When the file descriptor is readable, call @ref glfwDispatchReadyEvents.
+ *  Do not read from or close the file descriptor.  Calling this function again
+ *  returns the same file descriptor.
+ *
+ *  @return The file descriptor, or `-1` if an [error](@ref error_handling)
+ *  occurred.
+ *
+ *  @errors Possible errors include @ref GLFW_NOT_INITIALIZED, @ref
+ *  GLFW_FEATURE_UNAVAILABLE and @ref GLFW_PLATFORM_ERROR.
+ *
+ *  @remark This is only supported on X11, Wayland and the null platform on
+ *  Linux.  Elsewhere this function emits @ref GLFW_FEATURE_UNAVAILABLE.
+ *
+ *  @remark Some GLFW functions wait for replies from the window system and
+ *  may read events into an internal queue.  Call @ref glfwDispatchReadyEvents
+ *  once per iteration of your event loop after calling other GLFW functions,
+ *  so that such events are not left waiting.
+ *
+ *  @thread_safety This function must only be called from the main thread.
+ *
+ *  @sa @ref events_loop_fd
+ *  @sa @ref glfwDispatchReadyEvents
+ *
+ *  @since Added in version 3.4.
+ *
+ *  @ingroup window
+ */
+GLFWAPI int glfwGetEventLoopFd(void);
+
+/*! @brief Processes the events that are ready without blocking.
+ *
+ *  This function processes the events that are ready, calling the
+ *  associated callbacks, and returns immediately.  It also re-arms the
+ *  [event loop file descriptor](@ref glfwGetEventLoopFd) for any work left
+ *  and for the next GLFW timer.
+ *
+ *  @errors Possible errors include @ref GLFW_NOT_INITIALIZED and @ref
+ *  GLFW_PLATFORM_ERROR.
+ *
+ *  @reentrancy This function must not be called from a callback.
+ *
+ *  @thread_safety This function must only be called from the main thread.
+ *
+ *  @sa @ref events_loop_fd
+ *  @sa @ref glfwGetEventLoopFd
+ *
+ *  @since Added in version 3.4.
+ *
+ *  @ingroup window
+ */
+GLFWAPI void glfwDispatchReadyEvents(void);
+
+/*! @brief Posts a user event to the event queue.
+ *
+ *  This function posts a user event from the current thread to the event
+ *  queue, causing @ref glfwWaitEvents or @ref glfwWaitEventsTimeout to return.
+ *  The event is delivered on the main thread to the
+ *  [user event callback](@ref glfwSetUserEventCallback) by the next call to
+ *  @ref glfwPollEvents, @ref glfwWaitEvents or @ref glfwWaitEventsTimeout.
+ *  Events are delivered in the order they were posted.
+ *
+ *  The queue has a fixed capacity and this function does not block.  If the
+ *  main thread has fallen so far behind that the queue is full, the event is
+ *  not posted.
+ *
+ *  @param[in] payload A pointer to pass to the callback.  GLFW does not use
+ *  or free it.
+ *  @param[in] tag An integer to pass to the callback.
+ *  @return `GLFW_TRUE` if the event was posted, or `GLFW_FALSE` if the queue
+ *  was full or an [error](@ref error_handling) occurred.
+ *
+ *  @errors Possible errors include @ref GLFW_NOT_INITIALIZED and @ref
+ *  GLFW_PLATFORM_ERROR.
+ *
+ *  @thread_safety This function may be called from any thread.
+ *
+ *  @sa @ref events_user
+ *  @sa @ref glfwSetUserEventCallback
+ *
+ *  @since Added in version 3.4.
+ *
+ *  @ingroup window
+ */
+GLFWAPI int glfwPostUserEvent(void* payload, int tag);
+
+/*! @brief Sets the user event callback.
+ *
+ *  This function sets the user event callback, which is called on the main
+ *  thread for each event posted with @ref glfwPostUserEvent.  Events that
+ *  arrive while no callback is set are discarded.
+ *
+ *  @param[in] callback The new callback, or `NULL` to remove the currently set
+ *  callback.
+ *  @return The previously set callback, or `NULL` if no callback was set or the
+ *  library had not been [initialized](@ref intro_init).
+ *
+ *  @callback_signature
+ *  @code
+ *  void function_name(void* payload, int tag)
+ *  @endcode
+ *  For more information about the callback parameters, see the
+ *  [function pointer type](@ref GLFWusereventfun).
+ *
+ *  @errors Possible errors include @ref GLFW_NOT_INITIALIZED.
+ *
+ *  @thread_safety This function must only be called from the main thread.
+ *
+ *  @sa @ref events_user
+ *  @sa @ref glfwPostUserEvent
+ *
+ *  @since Added in version 3.4.
+ *
+ *  @ingroup window
+ */
+GLFWAPI GLFWusereventfun glfwSetUserEventCallback(GLFWusereventfun callback);
+
+/*! @brief Watches a file descriptor during event processing.
+ *
+ *  This function adds the specified file descriptor to the set that GLFW
+ *  checks during event processing.  @ref glfwWaitEvents and @ref
+ *  glfwWaitEventsTimeout return when it becomes ready, and the callback is
+ *  called on the main thread by @ref glfwPollEvents, @ref glfwWaitEvents or
+ *  @ref glfwWaitEventsTimeout for as long as it stays ready.
+ *
+ *  Watching a file descriptor that is already watched replaces its events and
+ *  callback.  GLFW does not read from, write to or close the file descriptor.
+ *
+ *  @param[in] fd The file descriptor to watch.
+ *  @param[in] events A bit field of `GLFW_FD_READ` and `GLFW_FD_WRITE`.
+ *  @param[in] callback The function to call when the file descriptor is ready.
+ *  @return `GLFW_TRUE` if successful, or `GLFW_FALSE` if an
+ *  [error](@ref error_handling) occurred.
+ *
+ *  @errors Possible errors include @ref GLFW_NOT_INITIALIZED, @ref
+ *  GLFW_INVALID_VALUE and @ref GLFW_FEATURE_UNAVAILABLE.
+ *
+ *  @remark @win32 @macos File descriptor watches are not supported and this
+ *  function emits @ref GLFW_FEATURE_UNAVAILABLE.  This includes the null
+ *  platform on Windows.
+ *
+ *  @thread_safety This function must only be called from the main thread.
+ *
+ *  @sa @ref events_fd
+ *  @sa @ref glfwUnwatchFd
+ *
+ *  @since Added in version 3.4.
+ *
+ *  @ingroup window
+ */
+GLFWAPI int glfwWatchFd(int fd, int events, GLFWfdfun callback);
+
+/*! @brief Stops watching a file descriptor.
+ *
+ *  This function removes the specified file descriptor from the set that GLFW
+ *  checks during event processing.  It may be called from a watch callback.
+ *  Remove a file descriptor before closing it.
+ *
+ *  @param[in] fd The file descriptor to stop watching.
+ *
+ *  @errors Possible errors include @ref GLFW_NOT_INITIALIZED.
+ *
+ *  @thread_safety This function must only be called from the main thread.
+ *
+ *  @sa @ref events_fd
+ *  @sa @ref glfwWatchFd
+ *
+ *  @since Added in version 3.4.
+ *
+ *  @ingroup window
+ */
+GLFWAPI void glfwUnwatchFd(int fd);
+
 /*! @brief Returns the value of an input option for the specified window.
  *
  *  This function returns the value of an input option for the specified window.
  *  The mode must be one of @ref GLFW_CURSOR, @ref GLFW_STICKY_KEYS,
- *  @ref GLFW_STICKY_MOUSE_BUTTONS, @ref GLFW_LOCK_KEY_MODS or
- *  @ref GLFW_RAW_MOUSE_MOTION.
+ *  @ref GLFW_STICKY_MOUSE_BUTTONS, @ref GLFW_LOCK_KEY_MODS,
+ *  @ref GLFW_RAW_MOUSE_MOTION or @ref GLFW_RAW_MOUSE_MOTION_EVENTS.
  *
  *  @param[in] window The window to query.
  *  @param[in] mode One of `GLFW_CURSOR`, `GLFW_STICKY_KEYS`,
- *  `GLFW_STICKY_MOUSE_BUTTONS`, `GLFW_LOCK_KEY_MODS` or
- *  `GLFW_RAW_MOUSE_MOTION`.
+ *  `GLFW_STICKY_MOUSE_BUTTONS`, `GLFW_LOCK_KEY_MODS`,
+ *  `GLFW_RAW_MOUSE_MOTION` or `GLFW_RAW_MOUSE_MOTION_EVENTS`.
  *
  *  @errors Possible errors include @ref GLFW_NOT_INITIALIZED and @ref
  *  GLFW_INVALID_ENUM.
@@ -4545,8 +5097,8 @@ GLFWAPI int glfwGetInputMode(GLFWwindow* window, int mode);
  *
  *  This function sets an input mode option for the specified window.  The mode
  *  must be one of @ref GLFW_CURSOR, @ref GLFW_STICKY_KEYS,
- *  @ref GLFW_STICKY_MOUSE_BUTTONS, @ref GLFW_LOCK_KEY_MODS or
- *  @ref GLFW_RAW_MOUSE_MOTION.
+ *  @ref GLFW_STICKY_MOUSE_BUTTONS, @ref GLFW_LOCK_KEY_MODS,
+ *  @ref GLFW_RAW_MOUSE_MOTION or @ref GLFW_RAW_MOUSE_MOTION_EVENTS.
  *
  *  If the mode is `GLFW_CURSOR`, the value must be one of the following cursor
  *  modes:
@@ -4584,10 +5136,17 @@ GLFWAPI int glfwGetInputMode(GLFWwindow* window, int mode);
  *  attempting to set this will emit @ref GLFW_FEATURE_UNAVAILABLE.  Call @ref
  *  glfwRawMouseMotionSupported to check for support.
  *
+ *  If the mode is `GLFW_RAW_MOUSE_MOTION_EVENTS`, the value must be either
+ *  `GLFW_TRUE` to report raw mouse motion through the
+ *  [cursor position callback](@ref glfwSetCursorPosCallback), or `GLFW_FALSE`
+ *  to only accumulate it for @ref glfwGetRawMouseDelta.  This is useful when
+ *  you only care about the total motion since the last frame and the mouse
+ *  reports at a high polling rate.  This is enabled by default.
+ *
  *  @param[in] window The window whose input mode to set.
  *  @param[in] mode One of `GLFW_CURSOR`, `GLFW_STICKY_KEYS`,
- *  `GLFW_STICKY_MOUSE_BUTTONS`, `GLFW_LOCK_KEY_MODS` or
- *  `GLFW_RAW_MOUSE_MOTION`.
+ *  `GLFW_STICKY_MOUSE_BUTTONS`, `GLFW_LOCK_KEY_MODS`,
+ *  `GLFW_RAW_MOUSE_MOTION` or `GLFW_RAW_MOUSE_MOTION_EVENTS`.
  *  @param[in] value The new value of the specified input mode.
  *
  *  @errors Possible errors include @ref GLFW_NOT_INITIALIZED, @ref
@@ -4794,6 +5353,69 @@ GLFWAPI int glfwGetKey(GLFWwindow* window, int key);
  */
 GLFWAPI int glfwGetMouseButton(GLFWwindow* window, int button);
 
+/*! @brief Retrieves the last reported state of all keyboard keys for the
+ *  specified window.
+ *
+ *  This function retrieves the last state reported for every key to the
+ *  specified window as a bit set.  The state of a key is stored in bit
+ *  `key % 64` of element `key / 64` of the array, where a set bit means that
+ *  @ref glfwGetKey would have returned `GLFW_PRESS` for that key.
+ *
+ *  If the @ref GLFW_STICKY_KEYS input mode is enabled, keys that were pressed
+ *  and have since been released are reported as pressed and then released,
+ *  exactly as if @ref glfwGetKey had been called for each of them.
+ *
+ *  This is equivalent to calling @ref glfwGetKey for every key token but only
+ *  copies a few words of memory.
+ *
+ *  @param[in] window The desired window.
+ *  @param[out] bits Where to store the key states.  This must point to an
+ *  array of at least @ref GLFW_KEYBOARD_STATE_WORDS elements.  If an error
+ *  occurs, all elements will be set to zero.
+ *
+ *  @errors Possible errors include @ref GLFW_NOT_INITIALIZED.
+ *
+ *  @thread_safety This function must only be called from the main thread.
+ *
+ *  @sa @ref input_key
+ *  @sa @ref glfwGetKey
+ *
+ *  @since Added in version 3.4.
+ *
+ *  @ingroup input
+ */
+GLFWAPI void glfwGetKeyboardState(GLFWwindow* window, uint64_t* bits);
+
+/*! @brief Returns the last reported state of all mouse buttons for the
+ *  specified window.
+ *
+ *  This function returns the last state reported for every mouse button to the
+ *  specified window as a bit mask.  The state of a mouse button is stored in
+ *  bit `button` of the returned value, where a set bit means that @ref
+ *  glfwGetMouseButton would have returned `GLFW_PRESS` for that button.
+ *
+ *  If the @ref GLFW_STICKY_MOUSE_BUTTONS input mode is enabled, mouse buttons
+ *  that were pressed and have since been released are reported as pressed and
+ *  then released, exactly as if @ref glfwGetMouseButton had been called for
+ *  each of them.
+ *
+ *  @param[in] window The desired window.
+ *  @return The bit mask of pressed mouse buttons, or zero if an
+ *  [error](@ref error_handling) occurred.
+ *
+ *  @errors Possible errors include @ref GLFW_NOT_INITIALIZED.
+ *
+ *  @thread_safety This function must only be called from the main thread.
+ *
+ *  @sa @ref input_mouse_button
+ *  @sa @ref glfwGetMouseButton
+ *
+ *  @since Added in version 3.4.
+ *
+ *  @ingroup input
+ */
+GLFWAPI int glfwGetMouseState(GLFWwindow* window);
+
 /*! @brief Retrieves the position of the cursor relative to the content area of
  *  the window.
  *
@@ -4832,6 +5454,41 @@ GLFWAPI int glfwGetMouseButton(GLFWwindow* window, int button);
  */
 GLFWAPI void glfwGetCursorPos(GLFWwindow* window, double* xpos, double* ypos);
 
+/*! @brief Retrieves and resets the raw mouse motion accumulated for the
+ *  window.
+ *
+ *  This function returns the sum of all raw (unscaled and unaccelerated) mouse
+ *  motion received for the specified window since the last call to this
+ *  function, and then resets it to zero.  Motion is only accumulated while the
+ *  cursor is disabled and [raw mouse motion](@ref GLFW_RAW_MOUSE_MOTION) is
+ *  enabled.
+ *
+ *  Raw motion is accumulated whether or not it is also reported through the
+ *  cursor position callback.  Set the @ref GLFW_RAW_MOUSE_MOTION_EVENTS input
+ *  mode to `GLFW_FALSE` to disable those callbacks and only use this function.
+ *
+ *  Any or all of the delta arguments may be `NULL`.  If an error occurs, all
+ *  non-`NULL` delta arguments will be set to zero.
+ *
+ *  @param[in] window The desired window.
+ *  @param[out] xdelta Where to store the accumulated horizontal motion, or
+ *  `NULL`.
+ *  @param[out] ydelta Where to store the accumulated vertical motion, or
+ *  `NULL`.
+ *
+ *  @errors Possible errors include @ref GLFW_NOT_INITIALIZED.
+ *
+ *  @thread_safety This function must only be called from the main thread.
+ *
+ *  @sa @ref raw_mouse_motion
+ *  @sa @ref glfwSetInputMode
+ *
+ *  @since Added in version 3.4.
+ *
+ *  @ingroup input
+ */
+GLFWAPI void glfwGetRawMouseDelta(GLFWwindow* window, double* xdelta, double* ydelta);
+
 /*! @brief Sets the position of the cursor, relative to the content area of the
  *  window.
  *
@@ -5147,6 +5804,46 @@ GLFWAPI GLFWcharfun glfwSetCharCallback(GLFWwindow* window, GLFWcharfun callback
  */
 GLFWAPI GLFWcharmodsfun glfwSetCharModsCallback(GLFWwindow* window, GLFWcharmodsfun callback);
 
+/*! @brief Sets the text input callback.
+ *
+ *  This function sets the text input callback of the specified window, which is
+ *  called with the complete UTF-8 encoded string each time text is input.
+ *
+ *  Unlike the [character callback](@ref glfwSetCharCallback), which is called
+ *  once for every character, this callback receives all characters produced by
+ *  a single input event at once.  This includes for example text committed by
+ *  an input method.  Like the character callback, it will not be called if
+ *  modifier keys are held down that would prevent normal text input on that
+ *  platform.
+ *
+ *  If both this and the character callback are set, this callback is called
+ *  first.
+ *
+ *  @param[in] window The window whose callback to set.
+ *  @param[in] callback The new callback, or `NULL` to remove the currently set
+ *  callback.
+ *  @return The previously set callback, or `NULL` if no callback was set or the
+ *  library had not been [initialized](@ref intro_init).
+ *
+ *  @callback_signature
+ *  @code
+ *  void function_name(GLFWwindow* window, const char* text)
+ *  @endcode
+ *  For more information about the callback parameters, see the
+ *  [function pointer type](@ref GLFWtextfun).
+ *
+ *  @errors Possible errors include @ref GLFW_NOT_INITIALIZED.
+ *
+ *  @thread_safety This function must only be called from the main thread.
+ *
+ *  @sa @ref input_char
+ *
+ *  @since Added in version 3.4.
+ *
+ *  @ingroup input
+ */
+GLFWAPI GLFWtextfun glfwSetTextCallback(GLFWwindow* window, GLFWtextfun callback);
+
 /*! @brief Sets the mouse button callback.
  *
  *  This function sets the mouse button callback of the specified window, which
@@ -5920,6 +6617,108 @@ GLFWAPI uint64_t glfwGetTimerValue(void);
  */
 GLFWAPI uint64_t glfwGetTimerFrequency(void);
 
+/*! @brief Creates a timer.
+ *
+ *  This function creates a timer that expires after the specified interval.
+ *  Expired timers call their callback on the main thread during @ref
+ *  glfwPollEvents, @ref glfwWaitEvents and @ref glfwWaitEventsTimeout, and
+ *  the waiting functions return no later than when the next timer expires.
+ *
+ *  A repeating timer expires again every interval after that, without
+ *  drifting.  If event processing falls behind by more than an interval, the
+ *  callback is called only once and the missed expirations are skipped.
+ *
+ *  A timer that does not repeat stays valid after it has expired, until it is
+ *  destroyed with @ref glfwDestroyTimer.  Any remaining timers are destroyed
+ *  when the library is terminated.
+ *
+ *  @param[in] interval The interval, in seconds, until the timer expires.
+ *  This must be a positive finite number.
+ *  @param[in] repeat `GLFW_TRUE` to make the timer expire every interval
+ *  until it is destroyed, or `GLFW_FALSE` to make it expire once.
+ *  @param[in] callback The function to call when the timer expires.
+ *  @return The handle of the created timer, or `NULL` if an
+ *  [error](@ref error_handling) occurred.
+ *
+ *  @errors Possible errors include @ref GLFW_NOT_INITIALIZED and @ref
+ *  GLFW_INVALID_VALUE.
+ *
+ *  @thread_safety This function must only be called from the main thread.
+ *
+ *  @sa @ref time_timers
+ *  @sa @ref glfwDestroyTimer
+ *
+ *  @since Added in version 3.4.
+ *
+ *  @ingroup input
+ */
+GLFWAPI GLFWtimer* glfwCreateTimer(double interval, int repeat, GLFWtimerfun callback);
+
+/*! @brief Destroys a timer.
+ *
+ *  This function destroys a timer previously created with @ref
+ *  glfwCreateTimer.  It may be called from the callback of any timer,
+ *  including the one being destroyed.
+ *
+ *  @param[in] timer The timer object to destroy.
+ *
+ *  @errors Possible errors include @ref GLFW_NOT_INITIALIZED.
+ *
+ *  @reentrancy This function may be called from a timer callback.
+ *
+ *  @thread_safety This function must only be called from the main thread.
+ *
+ *  @sa @ref time_timers
+ *  @sa @ref glfwCreateTimer
+ *
+ *  @since Added in version 3.4.
+ *
+ *  @ingroup input
+ */
+GLFWAPI void glfwDestroyTimer(GLFWtimer* timer);
+
+/*! @brief Sets the user pointer of the specified timer.
+ *
+ *  This function sets the user-defined pointer of the specified timer.  The
+ *  current value is retained until the timer is destroyed.  The initial value
+ *  is `NULL`.
+ *
+ *  @param[in] timer The timer whose pointer to set.
+ *  @param[in] pointer The new value.
+ *
+ *  @errors Possible errors include @ref GLFW_NOT_INITIALIZED.
+ *
+ *  @thread_safety This function must only be called from the main thread.
+ *
+ *  @sa @ref time_timers
+ *  @sa @ref glfwGetTimerUserPointer
+ *
+ *  @since Added in version 3.4.
+ *
+ *  @ingroup input
+ */
+GLFWAPI void glfwSetTimerUserPointer(GLFWtimer* timer, void* pointer);
+
+/*! @brief Returns the user pointer of the specified timer.
+ *
+ *  This function returns the current value of the user-defined pointer of the
+ *  specified timer.  The initial value is `NULL`.
+ *
+ *  @param[in] timer The timer whose pointer to return.
+ *
+ *  @errors Possible errors include @ref GLFW_NOT_INITIALIZED.
+ *
+ *  @thread_safety This function must only be called from the main thread.
+ *
+ *  @sa @ref time_timers
+ *  @sa @ref glfwSetTimerUserPointer
+ *
+ *  @since Added in version 3.4.
+ *
+ *  @ingroup input
+ */
+GLFWAPI void* glfwGetTimerUserPointer(GLFWtimer* timer);
+
 /*! @brief Makes the context of the specified window current for the calling
  *  thread.
  *
@@ -5986,9 +6785,9 @@ GLFWAPI GLFWwindow* glfwGetCurrentContext(void);
  *  zero, the GPU driver waits the specified number of screen updates before
  *  swapping the buffers.
  *
- *  The specified window must have an OpenGL or OpenGL ES context.  Specifying
- *  a window without a context will generate a @ref GLFW_NO_WINDOW_CONTEXT
- *  error.
+ *  The specified window must have an OpenGL or OpenGL ES context or a
+ *  [software framebuffer](@ref window_software).  Specifying a window without
+ *  either will generate a @ref GLFW_NO_WINDOW_CONTEXT error.
  *
  *  This function does not apply to Vulkan.  If you are rendering with Vulkan,
  *  see `vkQueuePresentKHR` instead.
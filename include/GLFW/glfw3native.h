@@ -62,6 +62,7 @@ extern "C" {
  *  * `GLFW_EXPOSE_NATIVE_COCOA`
  *  * `GLFW_EXPOSE_NATIVE_X11`
  *  * `GLFW_EXPOSE_NATIVE_WAYLAND`
+ *  * `GLFW_EXPOSE_NATIVE_NULL`
  *
  *  The available context API macros are:
  *  * `GLFW_EXPOSE_NATIVE_WGL`
@@ -467,6 +468,129 @@ GLFWAPI struct wl_output* glfwGetWaylandMonitor(GLFWmonitor* monitor);
 GLFWAPI struct wl_surface* glfwGetWaylandWindow(GLFWwindow* window);
 #endif
 
+#if defined(GLFW_EXPOSE_NATIVE_NULL)
+/*! @brief The value of the `magic` member of @ref GLFWframeexport.
+ *
+ *  @ingroup native
+ */
+#define GLFW_FRAME_EXPORT_MAGIC 0x58454647
+
+/*! @brief Header of a frame export ring.
+ *
+ *  This describes the start of the shared memory returned by @ref
+ *  glfwGetNullFrameExportFd.  It is followed by `slotCount` slots of
+ *  `slotSize` bytes each, starting at `slotOffset` bytes from the start of the
+ *  shared memory.  Frame number `n` is stored in slot `n % slotCount`.
+ *
+ *  The `sequence` member is odd while GLFW is resizing the shared memory.
+ *  When it has changed since you mapped the memory, map it again using the
+ *  current size of the file.
+ *
+ *  @ingroup native
+ */
+typedef struct GLFWframeexport
+{
+    /*! This is always `GLFW_FRAME_EXPORT_MAGIC`.
+     */
+    uint32_t magic;
+    /*! The version of this layout, currently 1.
+     */
+    uint32_t version;
+    /*! The layout sequence number.
+     */
+    volatile uint32_t sequence;
+    /*! The number of the most recently published frame, or zero if no frame
+     *  has been published.
+     */
+    volatile uint32_t frame;
+    /*! The number of slots in the ring.
+     */
+    uint32_t slotCount;
+    /*! The offset, in bytes, of the first slot.
+     */
+    uint32_t slotOffset;
+    /*! The size, in bytes, of each slot, including its header.
+     */
+    uint64_t slotSize;
+} GLFWframeexport;
+
+/*! @brief Header of a slot in a frame export ring.
+ *
+ *  This describes the start of each slot of a @ref GLFWframeexport ring.  The
+ *  pixels of the frame are 32-bit RGBA, the same as @ref GLFWimage, arranged
+ *  in rows from the top down.
+ *
+ *  The `sequence` member is odd while GLFW is writing to the slot.  To read
+ *  a frame, load `sequence` and retry if it is odd, read the frame, then load
+ *  `sequence` again and discard the frame if it has changed.  Also discard the
+ *  frame if the `sequence` member of the @ref GLFWframeexport header has
+ *  changed since you loaded the slot, as the slots may then have moved.
+ *
+ *  @ingroup native
+ */
+typedef struct GLFWframeslot
+{
+    /*! The slot sequence number.
+     */
+    volatile uint32_t sequence;
+    /*! The number of the frame in this slot, or zero if it is empty.
+     */
+    uint32_t frame;
+    /*! The width, in pixels, of the frame.
+     */
+    uint32_t width;
+    /*! The height, in pixels, of the frame.
+     */
+    uint32_t height;
+    /*! The distance, in bytes, between the start of consecutive rows.
+     */
+    uint32_t stride;
+    /*! The offset, in bytes, of the pixels from the start of the slot.
+     */
+    uint32_t offset;
+    /*! The `CLOCK_MONOTONIC` time, in nanoseconds, when the frame was
+     *  published.
+     */
+    uint64_t timestamp;
+} GLFWframeslot;
+
+/*! @brief Returns the frame export file descriptor of the specified window.
+ *
+ *  This function returns a file descriptor for the shared memory that frames
+ *  of the specified window are published to on each call to @ref
+ *  glfwSwapBuffers, if the window was created with the
+ *  [GLFW_NULL_FRAME_EXPORT](@ref GLFW_NULL_FRAME_EXPORT_hint) hint.  Pass it to
+ *  another process, for example over a Unix domain socket, and map it there
+ *  to read the frames without copying them.  The memory starts with
+ *  a @ref GLFWframeexport header.
+ *
+ *  @param[in] window The window to query.
+ *  @return The file descriptor, or -1 if frame export is not enabled for the
+ *  window or an [error](@ref error_handling) occurred.
+ *
+ *  @errors Possible errors include @ref GLFW_NOT_INITIALIZED, @ref
+ *  GLFW_PLATFORM_UNAVAILABLE and @ref GLFW_FEATURE_UNAVAILABLE.
+ *
+ *  @remark Frames are published from windows with a
+ *  [software framebuffer](@ref window_software) or an OSMesa context.
+ *
+ *  @remark @win32 Frame export is not supported and this function emits @ref
+ *  GLFW_FEATURE_UNAVAILABLE.
+ *
+ *  @pointer_lifetime The file descriptor is owned by GLFW and is closed when
+ *  the window is destroyed.  Duplicate it with `dup` if you need it for
+ *  longer.
+ *
+ *  @thread_safety This function may be called from any thread.  Access is not
+ *  synchronized.
+ *
+ *  @since Added in version 3.4.
+ *
+ *  @ingroup native
+ */
+GLFWAPI int glfwGetNullFrameExportFd(GLFWwindow* window);
+#endif
+
 #if defined(GLFW_EXPOSE_NATIVE_EGL)
 /*! @brief Returns the `EGLDisplay` used by GLFW.
  *
@@ -247,6 +247,9 @@ void _glfwSetWindowFloatingCocoa(_GLFWwindow* window, GLFWbool enabled);
 float _glfwGetWindowOpacityCocoa(_GLFWwindow* window);
 void _glfwSetWindowOpacityCocoa(_GLFWwindow* window, float opacity);
 void _glfwSetWindowMousePassthroughCocoa(_GLFWwindow* window, GLFWbool enabled);
+unsigned char* _glfwGetWindowPixelsCocoa(_GLFWwindow* window, int* stride);
+void _glfwSwapWindowPixelsCocoa(_GLFWwindow* window);
+void _glfwPresentPixelsCocoa(_GLFWwindow* window, const unsigned char* pixels, int stride, int width, int height, const GLFWrect* area);
 
 void _glfwSetRawMouseMotionCocoa(_GLFWwindow *window, GLFWbool enabled);
 GLFWbool _glfwRawMouseMotionSupportedCocoa(void);
@@ -255,6 +258,7 @@ void _glfwPollEventsCocoa(void);
 void _glfwWaitEventsCocoa(void);
 void _glfwWaitEventsTimeoutCocoa(double timeout);
 void _glfwPostEmptyEventCocoa(void);
+int _glfwGetEventLoopFdCocoa(void);
 
 void _glfwGetCursorPosCocoa(_GLFWwindow* window, double* xpos, double* ypos);
 void _glfwSetCursorPosCocoa(_GLFWwindow* window, double xpos, double ypos);
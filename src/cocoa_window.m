@@ -729,6 +729,11 @@ static const NSRange kEmptyRange = { NSNotFound, 0 };
     else
         characters = (NSString*) string;
 
+    // Every UTF-16 code unit encodes to at most three bytes of UTF-8 and every
+    // surrogate pair to four
+    char* text = _glfw_calloc([characters length] * 3 + 1, 1);
+    char* tp = text;
+
     NSRange range = NSMakeRange(0, [characters length]);
     while (range.length)
     {
@@ -745,9 +750,13 @@ static const NSRange kEmptyRange = { NSNotFound, 0 };
             if (codepoint >= 0xf700 && codepoint <= 0xf7ff)
                 continue;
 
-            _glfwInputChar(window, codepoint, mods, plain);
+            tp += _glfwEncodeUTF8(tp, codepoint);
         }
     }
+
+    *tp = '\0';
+    _glfwInputText(window, text, mods, plain);
+    _glfw_free(text);
 }
 
 - (void)doCommandBySelector:(SEL)selector
@@ -1376,6 +1385,26 @@ void _glfwSetWindowMousePassthroughCocoa(_GLFWwindow* window, GLFWbool enabled)
     }
 }
 
+unsigned char* _glfwGetWindowPixelsCocoa(_GLFWwindow* window, int* stride)
+{
+    _glfwInputError(GLFW_FEATURE_UNAVAILABLE,
+                    "Cocoa: Software framebuffers are not supported");
+    return NULL;
+}
+
+void _glfwSwapWindowPixelsCocoa(_GLFWwindow* window)
+{
+}
+
+void _glfwPresentPixelsCocoa(_GLFWwindow* window,
+                             const unsigned char* pixels,
+                             int stride, int width, int height,
+                             const GLFWrect* area)
+{
+    _glfwInputError(GLFW_FEATURE_UNAVAILABLE,
+                    "Cocoa: Software presentation is not supported");
+}
+
 float _glfwGetWindowOpacityCocoa(_GLFWwindow* window)
 {
     @autoreleasepool {
@@ -1473,6 +1502,13 @@ void _glfwPostEmptyEventCocoa(void)
     } // autoreleasepool
 }
 
+int _glfwGetEventLoopFdCocoa(void)
+{
+    _glfwInputError(GLFW_FEATURE_UNAVAILABLE,
+                    "Cocoa: The event loop has no file descriptor");
+    return -1;
+}
+
 void _glfwGetCursorPosCocoa(_GLFWwindow* window, double* xpos, double* ypos)
 {
     @autoreleasepool {
@@ -643,6 +643,12 @@ GLFWAPI void glfwSwapBuffers(GLFWwindow* handle)
 
     _GLFW_REQUIRE_INIT();
 
+    if (window->softwareFramebuffer)
+    {
+        _glfw.platform.swapWindowPixels(window);
+        return;
+    }
+
     if (window->context.client == GLFW_NO_API)
     {
         _glfwInputError(GLFW_NO_WINDOW_CONTEXT,
@@ -314,6 +314,7 @@ GLFWbool _glfwInitEGL(void)
     int i;
     EGLint* attribs = NULL;
     const char* extensions;
+    uint64_t start;
     const char* sonames[] =
     {
 #if defined(_GLFW_EGL_LIBRARY)
@@ -336,6 +337,8 @@ GLFWbool _glfwInitEGL(void)
     if (_glfw.egl.handle)
         return GLFW_TRUE;
 
+    start = _glfwPlatformGetTimerValue();
+
     for (i = 0;  sonames[i];  i++)
     {
         _glfw.egl.handle = _glfwPlatformLoadModule(sonames[i]);
@@ -486,6 +489,7 @@ GLFWbool _glfwInitEGL(void)
     _glfw.egl.EXT_present_opaque =
         extensionSupportedEGL("EGL_EXT_present_opaque");
 
+    _glfwRecordModuleTime("EGL", start);
     return GLFW_TRUE;
 }
 
@@ -271,6 +271,8 @@ GLFWbool _glfwInitGLX(void)
     if (_glfw.glx.handle)
         return GLFW_TRUE;
 
+    const uint64_t start = _glfwPlatformGetTimerValue();
+
     for (int i = 0;  sonames[i];  i++)
     {
         _glfw.glx.handle = _glfwPlatformLoadModule(sonames[i]);
@@ -418,6 +420,7 @@ GLFWbool _glfwInitGLX(void)
     if (extensionSupportedGLX("GLX_ARB_context_flush_control"))
         _glfw.glx.ARB_context_flush_control = GLFW_TRUE;
 
+    _glfwRecordModuleTime("GLX", start);
     return GLFW_TRUE;
 }
 
@@ -61,6 +61,8 @@ static _GLFWinitconfig _glfwInitHints =
     },
     {
         GLFW_TRUE,  // X11 XCB Vulkan surface
+        GLFW_FALSE, // X11 motion compression
+        GLFW_TRUE,  // X11 MIT-SHM presentation
     },
 };
 
@@ -85,6 +87,24 @@ static void* defaultReallocate(void* block, size_t size, void* user)
     return realloc(block, size);
 }
 
+// Records how long the specified module took to load, from the specified timer
+// value until now
+// The module lock must be held, as modules may be loaded from any thread
+//
+static void recordModuleTime(const char* name, uint64_t start)
+{
+    const uint64_t elapsed = _glfwPlatformGetTimerValue() - start;
+    GLFWmoduletime* entry;
+
+    if (_glfw.moduleTimeCount == _GLFW_MODULE_TIME_COUNT)
+        return;
+
+    entry = _glfw.moduleTimes + _glfw.moduleTimeCount;
+    entry->name = name;
+    entry->seconds = (double) elapsed / _glfwPlatformGetTimerFrequency();
+    _glfw.moduleTimeCount++;
+}
+
 // Terminate the library
 //
 static void terminate(void)
@@ -99,6 +119,11 @@ static void terminate(void)
     while (_glfw.cursorListHead)
         glfwDestroyCursor((GLFWcursor*) _glfw.cursorListHead);
 
+    while (_glfw.timerListHead)
+        glfwDestroyTimer((GLFWtimer*) _glfw.timerListHead);
+
+    _glfw_free(_glfw.fdWatches);
+
     for (i = 0;  i < _glfw.monitorCount;  i++)
     {
         _GLFWmonitor* monitor = _glfw.monitors[i];
@@ -131,6 +156,7 @@ static void terminate(void)
     _glfwPlatformDestroyTls(&_glfw.contextSlot);
     _glfwPlatformDestroyTls(&_glfw.errorSlot);
     _glfwPlatformDestroyMutex(&_glfw.errorLock);
+    _glfwPlatformDestroyMutex(&_glfw.moduleLock);
 
     memset(&_glfw, 0, sizeof(_glfw));
 }
@@ -171,6 +197,29 @@ size_t _glfwEncodeUTF8(char* s, uint32_t codepoint)
     return count;
 }
 
+// Decode a Unicode code point from a UTF-8 stream
+// Based on cutef8 by Jeff Bezanson (Public Domain)
+//
+uint32_t _glfwDecodeUTF8(const char** s)
+{
+    uint32_t codepoint = 0, count = 0;
+    static const uint32_t offsets[] =
+    {
+        0x00000000u, 0x00003080u, 0x000e2080u,
+        0x03c82080u, 0xfa082080u, 0x82082080u
+    };
+
+    do
+    {
+        codepoint = (codepoint << 6) + (unsigned char) **s;
+        (*s)++;
+        count++;
+    } while ((**s & 0xc0) == 0x80);
+
+    assert(count <= 6);
+    return codepoint - offsets[count - 1];
+}
+
 char* _glfw_strdup(const char* source)
 {
     const size_t length = strlen(source);
@@ -256,6 +305,35 @@ void _glfw_free(void* block)
         _glfw.allocator.deallocate(block, _glfw.allocator.user);
 }
 
+// Records how long the specified module took to load, from the specified timer
+// value until now
+//
+void _glfwRecordModuleTime(const char* name, uint64_t start)
+{
+    _glfwPlatformLockMutex(&_glfw.moduleLock);
+    recordModuleTime(name, start);
+    _glfwPlatformUnlockMutex(&_glfw.moduleLock);
+}
+
+// Loads an optional module the first time it is needed, using the specified
+// flag to remember that it has been loaded
+// A module that failed to load is not looked for again
+//
+void _glfwLoadModuleOnce(GLFWbool* loaded, const char* name, void (*load)(void))
+{
+    _glfwPlatformLockMutex(&_glfw.moduleLock);
+
+    if (!*loaded)
+    {
+        const uint64_t start = _glfwPlatformGetTimerValue();
+        load();
+        recordModuleTime(name, start);
+        *loaded = GLFW_TRUE;
+    }
+
+    _glfwPlatformUnlockMutex(&_glfw.moduleLock);
+}
+
 
 //////////////////////////////////////////////////////////////////////////
 //////                         GLFW event API                       //////
@@ -342,12 +420,17 @@ void _glfwInputError(int code, const char* format, ...)
 
 GLFWAPI int glfwInit(void)
 {
+    unsigned int i;
+
     if (_glfw.initialized)
         return GLFW_TRUE;
 
     memset(&_glfw, 0, sizeof(_glfw));
     _glfw.hints.init = _glfwInitHints;
 
+    for (i = 0;  i < _GLFW_USER_EVENT_COUNT;  i++)
+        _glfw.userEvents.cells[i].sequence = i;
+
     _glfw.allocator = _glfwInitAllocator;
     if (!_glfw.allocator.allocate)
     {
@@ -359,6 +442,16 @@ GLFWAPI int glfwInit(void)
     if (!_glfwSelectPlatform(_glfw.hints.init.platformID, &_glfw.platform))
         return GLFW_FALSE;
 
+    // The timer and module lock are needed for timing modules loaded by the
+    // platform during initialization
+    _glfwPlatformInitTimer();
+
+    if (!_glfwPlatformCreateMutex(&_glfw.moduleLock))
+    {
+        terminate();
+        return GLFW_FALSE;
+    }
+
     if (!_glfw.platform.init())
     {
         terminate();
@@ -377,7 +470,6 @@ GLFWAPI int glfwInit(void)
 
     _glfwInitGamepadMappings();
 
-    _glfwPlatformInitTimer();
     _glfw.timer.offset = _glfwPlatformGetTimerValue();
 
     _glfw.initialized = GLFW_TRUE;
@@ -416,6 +508,12 @@ GLFWAPI void glfwInitHint(int hint, int value)
         case GLFW_X11_XCB_VULKAN_SURFACE:
             _glfwInitHints.x11.xcbVulkanSurface = value;
             return;
+        case GLFW_X11_MOTION_COMPRESSION:
+            _glfwInitHints.x11.motionCompression = value;
+            return;
+        case GLFW_X11_SHARED_MEMORY:
+            _glfwInitHints.x11.sharedMemory = value;
+            return;
     }
 
     _glfwInputError(GLFW_INVALID_ENUM,
@@ -480,3 +578,19 @@ GLFWAPI GLFWerrorfun glfwSetErrorCallback(GLFWerrorfun cbfun)
     return cbfun;
 }
 
+GLFWAPI const GLFWmoduletime* glfwGetModuleLoadTimes(int* count)
+{
+    assert(count != NULL);
+
+    *count = 0;
+
+    _GLFW_REQUIRE_INIT_OR_RETURN(NULL);
+
+    // Modules may be loaded from other threads, but recorded entries never change
+    _glfwPlatformLockMutex(&_glfw.moduleLock);
+    *count = _glfw.moduleTimeCount;
+    _glfwPlatformUnlockMutex(&_glfw.moduleLock);
+
+    return _glfw.moduleTimes;
+}
+
@@ -44,6 +44,78 @@
 #define _GLFW_JOYSTICK_BUTTON   2
 #define _GLFW_JOYSTICK_HATBIT   3
 
+// Sets the state of a key and keeps the key bit sets in sync with it
+//
+static void setKeyState(_GLFWwindow* window, int key, char state)
+{
+    const int word = key / 64;
+    const uint64_t bit = (uint64_t) 1 << (key % 64);
+
+    window->keys[key] = state;
+
+    if (state == GLFW_RELEASE)
+        window->keyBits[word] &= ~bit;
+    else
+        window->keyBits[word] |= bit;
+
+    if (state == _GLFW_STICK)
+        window->stickyKeyBits[word] |= bit;
+    else
+        window->stickyKeyBits[word] &= ~bit;
+}
+
+// Sets the state of a mouse button and keeps the button bit sets in sync with it
+//
+static void setMouseButtonState(_GLFWwindow* window, int button, char state)
+{
+    const unsigned int bit = 1u << button;
+
+    window->mouseButtons[button] = state;
+
+    if (state == GLFW_RELEASE)
+        window->mouseButtonBits &= ~bit;
+    else
+        window->mouseButtonBits |= bit;
+
+    if (state == _GLFW_STICK)
+        window->stickyMouseButtonBits |= bit;
+    else
+        window->stickyMouseButtonBits &= ~bit;
+}
+
+// Returns the length of the control character at the start of the specified
+// UTF-8 string, or zero if it does not start with one
+//
+static size_t controlCharLength(const char* s)
+{
+    const unsigned char c = (unsigned char) s[0];
+
+    if (c < 0x20 || c == 0x7f)
+        return 1;
+    if (c == 0xc2 && (unsigned char) s[1] >= 0x80 && (unsigned char) s[1] <= 0x9f)
+        return 2;
+
+    return 0;
+}
+
+// Emits the character events for a single Unicode code point
+//
+static void inputCharacter(_GLFWwindow* window,
+                           uint32_t codepoint, int mods, GLFWbool plain)
+{
+    if (codepoint < 32 || (codepoint > 126 && codepoint < 160))
+        return;
+
+    if (window->callbacks.charmods)
+        window->callbacks.charmods((GLFWwindow*) window, codepoint, mods);
+
+    if (plain)
+    {
+        if (window->callbacks.character)
+            window->callbacks.character((GLFWwindow*) window, codepoint);
+    }
+}
+
 // Initializes the platform joystick API if it has not been already
 //
 static GLFWbool initJoysticks(void)
@@ -277,9 +349,9 @@ void _glfwInputKey(_GLFWwindow* window, int key, int scancode, int action, int m
             repeated = GLFW_TRUE;
 
         if (action == GLFW_RELEASE && window->stickyKeys)
-            window->keys[key] = _GLFW_STICK;
+            setKeyState(window, key, _GLFW_STICK);
         else
-            window->keys[key] = (char) action;
+            setKeyState(window, key, (char) action);
 
         if (repeated)
             action = GLFW_REPEAT;
@@ -292,8 +364,59 @@ void _glfwInputKey(_GLFWwindow* window, int key, int scancode, int action, int m
         window->callbacks.key((GLFWwindow*) window, key, scancode, action, mods);
 }
 
+// Notifies shared code of a UTF-8 encoded text input event
+// The 'plain' parameter determines whether to emit regular text and character
+// events
+//
+void _glfwInputText(_GLFWwindow* window, const char* text, int mods, GLFWbool plain)
+{
+    const char* c;
+
+    if (!window->lockKeyMods)
+        mods &= ~(GLFW_MOD_CAPS_LOCK | GLFW_MOD_NUM_LOCK);
+
+    if (plain && window->callbacks.text)
+    {
+        for (c = text;  *c;  c++)
+        {
+            if (controlCharLength(c))
+                break;
+        }
+
+        if (*c)
+        {
+            // Control characters are not text, so strip them from a copy
+            char* filtered = _glfw_calloc(strlen(text) + 1, 1);
+            char* f = filtered;
+
+            for (c = text;  *c;  )
+            {
+                const size_t length = controlCharLength(c);
+                if (length)
+                    c += length;
+                else
+                    *f++ = *c++;
+            }
+
+            if (*filtered)
+                window->callbacks.text((GLFWwindow*) window, filtered);
+
+            _glfw_free(filtered);
+        }
+        else if (*text)
+            window->callbacks.text((GLFWwindow*) window, text);
+    }
+
+    if (window->callbacks.charmods || window->callbacks.character)
+    {
+        for (c = text;  *c;  )
+            inputCharacter(window, _glfwDecodeUTF8(&c), mods, plain);
+    }
+}
+
 // Notifies shared code of a Unicode codepoint input event
-// The 'plain' parameter determines whether to emit a regular character event
+// The 'plain' parameter determines whether to emit regular text and character
+// events
 //
 void _glfwInputChar(_GLFWwindow* window, uint32_t codepoint, int mods, GLFWbool plain)
 {
@@ -303,14 +426,17 @@ void _glfwInputChar(_GLFWwindow* window, uint32_t codepoint, int mods, GLFWbool
     if (!window->lockKeyMods)
         mods &= ~(GLFW_MOD_CAPS_LOCK | GLFW_MOD_NUM_LOCK);
 
-    if (window->callbacks.charmods)
-        window->callbacks.charmods((GLFWwindow*) window, codepoint, mods);
-
-    if (plain)
+    if (plain && window->callbacks.text)
     {
-        if (window->callbacks.character)
-            window->callbacks.character((GLFWwindow*) window, codepoint);
+        char text[5];
+        const size_t length = _glfwEncodeUTF8(text, codepoint);
+        text[length] = '\0';
+
+        if (length)
+            window->callbacks.text((GLFWwindow*) window, text);
     }
+
+    inputCharacter(window, codepoint, mods, plain);
 }
 
 // Notifies shared code of a scroll event
@@ -332,9 +458,9 @@ void _glfwInputMouseClick(_GLFWwindow* window, int button, int action, int mods)
         mods &= ~(GLFW_MOD_CAPS_LOCK | GLFW_MOD_NUM_LOCK);
 
     if (action == GLFW_RELEASE && window->stickyMouseButtons)
-        window->mouseButtons[button] = _GLFW_STICK;
+        setMouseButtonState(window, button, _GLFW_STICK);
     else
-        window->mouseButtons[button] = (char) action;
+        setMouseButtonState(window, button, (char) action);
 
     if (window->callbacks.mouseButton)
         window->callbacks.mouseButton((GLFWwindow*) window, button, action, mods);
@@ -355,6 +481,27 @@ void _glfwInputCursorPos(_GLFWwindow* window, double xpos, double ypos)
         window->callbacks.cursorPos((GLFWwindow*) window, xpos, ypos);
 }
 
+// Notifies shared code of raw motion of a disabled cursor
+// The motion is specified as unscaled and unaccelerated deltas
+//
+void _glfwInputRawMouseMotion(_GLFWwindow* window, double dx, double dy)
+{
+    window->rawMouseDeltaX += dx;
+    window->rawMouseDeltaY += dy;
+
+    if (window->rawMouseMotionEvents)
+    {
+        _glfwInputCursorPos(window,
+                            window->virtualCursorPosX + dx,
+                            window->virtualCursorPosY + dy);
+    }
+    else
+    {
+        window->virtualCursorPosX += dx;
+        window->virtualCursorPosY += dy;
+    }
+}
+
 // Notifies shared code of a cursor enter/leave event
 //
 void _glfwInputCursorEnter(_GLFWwindow* window, GLFWbool entered)
@@ -485,6 +632,90 @@ void _glfwCenterCursorInContentArea(_GLFWwindow* window)
     _glfw.platform.setCursorPos(window, width / 2.0, height / 2.0);
 }
 
+// Retrieves the time, in seconds, until the next active timer expires
+// Returns GLFW_FALSE if there are no active timers
+//
+GLFWbool _glfwGetTimerTimeout(double* timeout)
+{
+    _GLFWtimer* timer;
+    uint64_t now, deadline = 0;
+    GLFWbool found = GLFW_FALSE;
+
+    for (timer = _glfw.timerListHead;  timer;  timer = timer->next)
+    {
+        if (!timer->active)
+            continue;
+
+        if (!found || timer->deadline < deadline)
+            deadline = timer->deadline;
+
+        found = GLFW_TRUE;
+    }
+
+    if (!found)
+        return GLFW_FALSE;
+
+    now = _glfwPlatformGetTimerValue();
+    if (deadline > now)
+        *timeout = (deadline - now) / (double) _glfwPlatformGetTimerFrequency();
+    else
+        *timeout = 0.0;
+
+    return GLFW_TRUE;
+}
+
+// Calls the callbacks of all expired timers
+//
+void _glfwFireTimers(void)
+{
+    _GLFWtimer* timer;
+    uint64_t now;
+
+    if (!_glfw.timerListHead)
+        return;
+
+    now = _glfwPlatformGetTimerValue();
+    timer = _glfw.timerListHead;
+
+    while (timer)
+    {
+        if (!timer->active || timer->deadline > now)
+        {
+            timer = timer->next;
+            continue;
+        }
+
+        if (timer->repeat)
+        {
+            // Skip any expirations that were missed while falling behind
+            timer->deadline += timer->interval;
+            if (timer->deadline <= now)
+            {
+                timer->deadline += ((now - timer->deadline) / timer->interval + 1) *
+                                   timer->interval;
+            }
+        }
+        else
+            timer->active = GLFW_FALSE;
+
+        if (timer->callback)
+            timer->callback((GLFWtimer*) timer);
+
+        // The callback may have created or destroyed any timer, so start over
+        // This terminates as no timer expires twice for the same time
+        timer = _glfw.timerListHead;
+    }
+}
+
+// Brings the event loop file descriptor up to date with the current watches
+// and timers, if the application is waiting on it
+//
+void _glfwUpdateEventLoop(void)
+{
+    if (_glfw.eventLoopFdUsed)
+        _glfw.platform.getEventLoopFd();
+}
+
 
 //////////////////////////////////////////////////////////////////////////
 //////                        GLFW public API                       //////
@@ -509,6 +740,8 @@ GLFWAPI int glfwGetInputMode(GLFWwindow* handle, int mode)
             return window->lockKeyMods;
         case GLFW_RAW_MOUSE_MOTION:
             return window->rawMouseMotion;
+        case GLFW_RAW_MOUSE_MOTION_EVENTS:
+            return window->rawMouseMotionEvents;
     }
 
     _glfwInputError(GLFW_INVALID_ENUM, "Invalid input mode 0x%08X", mode);
@@ -562,7 +795,7 @@ GLFWAPI void glfwSetInputMode(GLFWwindow* handle, int mode, int value)
                 for (i = 0;  i <= GLFW_KEY_LAST;  i++)
                 {
                     if (window->keys[i] == _GLFW_STICK)
-                        window->keys[i] = GLFW_RELEASE;
+                        setKeyState(window, i, GLFW_RELEASE);
                 }
             }
 
@@ -584,7 +817,7 @@ GLFWAPI void glfwSetInputMode(GLFWwindow* handle, int mode, int value)
                 for (i = 0;  i <= GLFW_MOUSE_BUTTON_LAST;  i++)
                 {
                     if (window->mouseButtons[i] == _GLFW_STICK)
-                        window->mouseButtons[i] = GLFW_RELEASE;
+                        setMouseButtonState(window, i, GLFW_RELEASE);
                 }
             }
 
@@ -612,9 +845,17 @@ GLFWAPI void glfwSetInputMode(GLFWwindow* handle, int mode, int value)
                 return;
 
             window->rawMouseMotion = value;
+            window->rawMouseDeltaX = 0.0;
+            window->rawMouseDeltaY = 0.0;
             _glfw.platform.setRawMouseMotion(window, value);
             return;
         }
+
+        case GLFW_RAW_MOUSE_MOTION_EVENTS:
+        {
+            window->rawMouseMotionEvents = value ? GLFW_TRUE : GLFW_FALSE;
+            return;
+        }
     }
 
     _glfwInputError(GLFW_INVALID_ENUM, "Invalid input mode 0x%08X", mode);
@@ -674,7 +915,7 @@ GLFWAPI int glfwGetKey(GLFWwindow* handle, int key)
     if (window->keys[key] == _GLFW_STICK)
     {
         // Sticky mode: release key now
-        window->keys[key] = GLFW_RELEASE;
+        setKeyState(window, key, GLFW_RELEASE);
         return GLFW_PRESS;
     }
 
@@ -697,13 +938,70 @@ GLFWAPI int glfwGetMouseButton(GLFWwindow* handle, int button)
     if (window->mouseButtons[button] == _GLFW_STICK)
     {
         // Sticky mode: release mouse button now
-        window->mouseButtons[button] = GLFW_RELEASE;
+        setMouseButtonState(window, button, GLFW_RELEASE);
         return GLFW_PRESS;
     }
 
     return (int) window->mouseButtons[button];
 }
 
+GLFWAPI void glfwGetKeyboardState(GLFWwindow* handle, uint64_t* bits)
+{
+    int i, j;
+    _GLFWwindow* window = (_GLFWwindow*) handle;
+    assert(window != NULL);
+    assert(bits != NULL);
+
+    memset(bits, 0, GLFW_KEYBOARD_STATE_WORDS * sizeof(uint64_t));
+
+    _GLFW_REQUIRE_INIT();
+
+    for (i = 0;  i < GLFW_KEYBOARD_STATE_WORDS;  i++)
+    {
+        bits[i] = window->keyBits[i];
+
+        if (!window->stickyKeyBits[i])
+            continue;
+
+        // Sticky mode: release keys now
+        for (j = 0;  j < 64;  j++)
+        {
+            if (window->stickyKeyBits[i] & ((uint64_t) 1 << j))
+                window->keys[i * 64 + j] = GLFW_RELEASE;
+        }
+
+        window->keyBits[i] &= ~window->stickyKeyBits[i];
+        window->stickyKeyBits[i] = 0;
+    }
+}
+
+GLFWAPI int glfwGetMouseState(GLFWwindow* handle)
+{
+    int i;
+    unsigned int bits;
+    _GLFWwindow* window = (_GLFWwindow*) handle;
+    assert(window != NULL);
+
+    _GLFW_REQUIRE_INIT_OR_RETURN(0);
+
+    bits = window->mouseButtonBits;
+
+    if (window->stickyMouseButtonBits)
+    {
+        // Sticky mode: release mouse buttons now
+        for (i = 0;  i <= GLFW_MOUSE_BUTTON_LAST;  i++)
+        {
+            if (window->stickyMouseButtonBits & (1u << i))
+                window->mouseButtons[i] = GLFW_RELEASE;
+        }
+
+        window->mouseButtonBits &= ~window->stickyMouseButtonBits;
+        window->stickyMouseButtonBits = 0;
+    }
+
+    return (int) bits;
+}
+
 GLFWAPI void glfwGetCursorPos(GLFWwindow* handle, double* xpos, double* ypos)
 {
     _GLFWwindow* window = (_GLFWwindow*) handle;
@@ -727,6 +1025,27 @@ GLFWAPI void glfwGetCursorPos(GLFWwindow* handle, double* xpos, double* ypos)
         _glfw.platform.getCursorPos(window, xpos, ypos);
 }
 
+GLFWAPI void glfwGetRawMouseDelta(GLFWwindow* handle, double* xdelta, double* ydelta)
+{
+    _GLFWwindow* window = (_GLFWwindow*) handle;
+    assert(window != NULL);
+
+    if (xdelta)
+        *xdelta = 0;
+    if (ydelta)
+        *ydelta = 0;
+
+    _GLFW_REQUIRE_INIT();
+
+    if (xdelta)
+        *xdelta = window->rawMouseDeltaX;
+    if (ydelta)
+        *ydelta = window->rawMouseDeltaY;
+
+    window->rawMouseDeltaX = 0.0;
+    window->rawMouseDeltaY = 0.0;
+}
+
 GLFWAPI void glfwSetCursorPos(GLFWwindow* handle, double xpos, double ypos)
 {
     _GLFWwindow* window = (_GLFWwindow*) handle;
@@ -762,20 +1081,65 @@ GLFWAPI void glfwSetCursorPos(GLFWwindow* handle, double xpos, double ypos)
 GLFWAPI GLFWcursor* glfwCreateCursor(const GLFWimage* image, int xhot, int yhot)
 {
     _GLFWcursor* cursor;
+    _GLFWcursor* source;
+    uint64_t hash;
+    size_t size;
 
     assert(image != NULL);
 
     _GLFW_REQUIRE_INIT_OR_RETURN(NULL);
 
+    hash = _glfwHashImage(image, ((uint64_t) xhot << 32) ^ (uint32_t) yhot);
+    size = (size_t) image->width * image->height * 4;
+
+    // Look for a cursor already created from the same image
+    for (source = _glfw.cursorListHead;  source;  source = source->next)
+    {
+        const _GLFWcursorImage* other = source->image;
+
+        if (other &&
+            other->hash == hash &&
+            other->width == image->width &&
+            other->height == image->height &&
+            other->xhot == xhot &&
+            other->yhot == yhot &&
+            memcmp(other->pixels, image->pixels, size) == 0)
+        {
+            break;
+        }
+    }
+
     cursor = _glfw_calloc(1, sizeof(_GLFWcursor));
-    cursor->next = _glfw.cursorListHead;
-    _glfw.cursorListHead = cursor;
 
-    if (!_glfw.platform.createCursor(cursor, image, xhot, yhot))
+    if (source)
+    {
+        // Share the native cursor instead of converting and uploading it again
+        *cursor = *source;
+        cursor->image->references++;
+    }
+    else if (!_glfw.platform.createCursor(cursor, image, xhot, yhot))
     {
+        cursor->next = _glfw.cursorListHead;
+        _glfw.cursorListHead = cursor;
+
         glfwDestroyCursor((GLFWcursor*) cursor);
         return NULL;
     }
+    else
+    {
+        cursor->image = _glfw_calloc(1, sizeof(_GLFWcursorImage));
+        cursor->image->hash = hash;
+        cursor->image->width = image->width;
+        cursor->image->height = image->height;
+        cursor->image->xhot = xhot;
+        cursor->image->yhot = yhot;
+        cursor->image->pixels = _glfw_calloc(size, 1);
+        cursor->image->references = 1;
+        memcpy(cursor->image->pixels, image->pixels, size);
+    }
+
+    cursor->next = _glfw.cursorListHead;
+    _glfw.cursorListHead = cursor;
 
     return (GLFWcursor*) cursor;
 }
@@ -834,7 +1198,17 @@ GLFWAPI void glfwDestroyCursor(GLFWcursor* handle)
         }
     }
 
-    _glfw.platform.destroyCursor(cursor);
+    if (cursor->image)
+    {
+        if (--cursor->image->references == 0)
+        {
+            _glfw.platform.destroyCursor(cursor);
+            _glfw_free(cursor->image->pixels);
+            _glfw_free(cursor->image);
+        }
+    }
+    else
+        _glfw.platform.destroyCursor(cursor);
 
     // Unlink cursor from global linked list
     {
@@ -882,6 +1256,16 @@ GLFWAPI GLFWcharfun glfwSetCharCallback(GLFWwindow* handle, GLFWcharfun cbfun)
     return cbfun;
 }
 
+GLFWAPI GLFWtextfun glfwSetTextCallback(GLFWwindow* handle, GLFWtextfun cbfun)
+{
+    _GLFWwindow* window = (_GLFWwindow*) handle;
+    assert(window != NULL);
+
+    _GLFW_REQUIRE_INIT_OR_RETURN(NULL);
+    _GLFW_SWAP(GLFWtextfun, window->callbacks.text, cbfun);
+    return cbfun;
+}
+
 GLFWAPI GLFWcharmodsfun glfwSetCharModsCallback(GLFWwindow* handle, GLFWcharmodsfun cbfun)
 {
     _GLFWwindow* window = (_GLFWwindow*) handle;
@@ -1421,3 +1805,77 @@ GLFWAPI uint64_t glfwGetTimerFrequency(void)
     _GLFW_REQUIRE_INIT_OR_RETURN(0);
     return _glfwPlatformGetTimerFrequency();
 }
+
+GLFWAPI GLFWtimer* glfwCreateTimer(double interval, int repeat, GLFWtimerfun callback)
+{
+    _GLFWtimer* timer;
+
+    assert(interval == interval);
+    assert(interval > 0.0);
+    assert(interval <= 18446744073.0);
+
+    _GLFW_REQUIRE_INIT_OR_RETURN(NULL);
+
+    if (interval != interval || interval <= 0.0 || interval > 18446744073.0)
+    {
+        _glfwInputError(GLFW_INVALID_VALUE, "Invalid timer interval %f", interval);
+        return NULL;
+    }
+
+    timer = _glfw_calloc(1, sizeof(_GLFWtimer));
+    timer->next = _glfw.timerListHead;
+    _glfw.timerListHead = timer;
+
+    timer->interval = (uint64_t) (interval * _glfwPlatformGetTimerFrequency());
+    if (!timer->interval)
+        timer->interval = 1;
+
+    timer->deadline = _glfwPlatformGetTimerValue() + timer->interval;
+    timer->repeat = repeat ? GLFW_TRUE : GLFW_FALSE;
+    timer->active = GLFW_TRUE;
+    timer->callback = callback;
+
+    _glfwUpdateEventLoop();
+    return (GLFWtimer*) timer;
+}
+
+GLFWAPI void glfwDestroyTimer(GLFWtimer* handle)
+{
+    _GLFWtimer* timer = (_GLFWtimer*) handle;
+
+    _GLFW_REQUIRE_INIT();
+
+    if (timer == NULL)
+        return;
+
+    // Unlink timer from global linked list
+    {
+        _GLFWtimer** prev = &_glfw.timerListHead;
+
+        while (*prev != timer)
+            prev = &((*prev)->next);
+
+        *prev = timer->next;
+    }
+
+    _glfw_free(timer);
+    _glfwUpdateEventLoop();
+}
+
+GLFWAPI void glfwSetTimerUserPointer(GLFWtimer* handle, void* pointer)
+{
+    _GLFWtimer* timer = (_GLFWtimer*) handle;
+    assert(timer != NULL);
+
+    _GLFW_REQUIRE_INIT();
+    timer->userPointer = pointer;
+}
+
+GLFWAPI void* glfwGetTimerUserPointer(GLFWtimer* handle)
+{
+    _GLFWtimer* timer = (_GLFWtimer*) handle;
+    assert(timer != NULL);
+
+    _GLFW_REQUIRE_INIT_OR_RETURN(NULL);
+    return timer->userPointer;
+}
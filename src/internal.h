@@ -58,6 +58,30 @@
 
 #define _GLFW_MESSAGE_SIZE      1024
 
+#define _GLFW_DAMAGE_RECT_COUNT 8
+#define _GLFW_USER_EVENT_COUNT  1024
+#define _GLFW_MODULE_TIME_COUNT 32
+
+// Target formats for _glfwConvertPixels, where ARGB32 is native-endian words
+#define _GLFW_PIXELS_ARGB32         0x01
+#define _GLFW_PIXELS_BGRA           0x02
+#define _GLFW_PIXELS_PREMULTIPLIED  0x10
+
+// Atomic operations on 32-bit unsigned integers, for the user event queue
+#if defined(_MSC_VER) && !defined(__clang__)
+ #include <intrin.h>
+ #define _glfwAtomicLoad(p) \
+     ((unsigned int) _InterlockedOr((volatile long*) (p), 0))
+ #define _glfwAtomicStore(p, v) \
+     _InterlockedExchange((volatile long*) (p), (long) (v))
+ #define _glfwAtomicCompareSwap(p, e, d) \
+     (_InterlockedCompareExchange((volatile long*) (p), (long) (d), (long) (e)) == (long) (e))
+#else
+ #define _glfwAtomicLoad(p) __atomic_load_n((p), __ATOMIC_ACQUIRE)
+ #define _glfwAtomicStore(p, v) __atomic_store_n((p), (v), __ATOMIC_RELEASE)
+ #define _glfwAtomicCompareSwap(p, e, d) __sync_bool_compare_and_swap((p), (e), (d))
+#endif
+
 typedef int GLFWbool;
 typedef void (*GLFWproc)(void);
 
@@ -72,11 +96,15 @@ typedef struct _GLFWplatform    _GLFWplatform;
 typedef struct _GLFWlibrary     _GLFWlibrary;
 typedef struct _GLFWmonitor     _GLFWmonitor;
 typedef struct _GLFWcursor      _GLFWcursor;
+typedef struct _GLFWcursorImage _GLFWcursorImage;
+typedef struct _GLFWtimer       _GLFWtimer;
 typedef struct _GLFWmapelement  _GLFWmapelement;
 typedef struct _GLFWmapping     _GLFWmapping;
 typedef struct _GLFWjoystick    _GLFWjoystick;
 typedef struct _GLFWtls         _GLFWtls;
 typedef struct _GLFWmutex       _GLFWmutex;
+typedef struct _GLFWuserevent   _GLFWuserevent;
+typedef struct _GLFWfdwatch     _GLFWfdwatch;
 
 #define GL_VERSION 0x1f02
 #define GL_NONE 0
@@ -107,6 +135,7 @@ typedef void (APIENTRY * PFNGLCLEARPROC)(GLbitfield);
 typedef const GLubyte* (APIENTRY * PFNGLGETSTRINGPROC)(GLenum);
 typedef void (APIENTRY * PFNGLGETINTEGERVPROC)(GLenum,GLint*);
 typedef const GLubyte* (APIENTRY * PFNGLGETSTRINGIPROC)(GLenum,GLuint);
+typedef void (APIENTRY * PFNGLFINISHPROC)(void);
 
 #if defined(_GLFW_WIN32)
  #define EGLAPIENTRY __stdcall
@@ -385,6 +414,8 @@ struct _GLFWinitconfig
     } ns;
     struct {
         GLFWbool  xcbVulkanSurface;
+        GLFWbool  motionCompression;
+        GLFWbool  sharedMemory;
     } x11;
 };
 
@@ -410,6 +441,7 @@ struct _GLFWwndconfig
     GLFWbool      focusOnShow;
     GLFWbool      mousePassthrough;
     GLFWbool      scaleToMonitor;
+    GLFWbool      softwareFramebuffer;
     struct {
         GLFWbool  retina;
         char      frameName[256];
@@ -421,6 +453,9 @@ struct _GLFWwndconfig
     struct {
         GLFWbool  keymenu;
     } win32;
+    struct {
+        int       exportSlots;
+    } null;
 };
 
 // Context configuration
@@ -530,6 +565,7 @@ struct _GLFWwindow
     GLFWbool            floating;
     GLFWbool            focusOnShow;
     GLFWbool            mousePassthrough;
+    GLFWbool            softwareFramebuffer;
     GLFWbool            shouldClose;
     void*               userPointer;
     GLFWbool            doublebuffer;
@@ -547,9 +583,23 @@ struct _GLFWwindow
     int                 cursorMode;
     char                mouseButtons[GLFW_MOUSE_BUTTON_LAST + 1];
     char                keys[GLFW_KEY_LAST + 1];
+    // Bit sets of pressed or sticky keys and buttons and of sticky ones only
+    uint64_t            keyBits[GLFW_KEYBOARD_STATE_WORDS];
+    uint64_t            stickyKeyBits[GLFW_KEYBOARD_STATE_WORDS];
+    unsigned int        mouseButtonBits;
+    unsigned int        stickyMouseButtonBits;
     // Virtual cursor position when cursor is disabled
     double              virtualCursorPosX, virtualCursorPosY;
     GLFWbool            rawMouseMotion;
+    GLFWbool            rawMouseMotionEvents;
+    // Raw motion accumulated since the last call to glfwGetRawMouseDelta
+    double              rawMouseDeltaX, rawMouseDeltaY;
+
+    // Damage accumulated since the last refresh and the damage it reported
+    GLFWrect            damage[_GLFW_DAMAGE_RECT_COUNT];
+    int                 damageCount;
+    GLFWrect            reportedDamage[_GLFW_DAMAGE_RECT_COUNT];
+    int                 reportedDamageCount;
 
     _GLFWcontext        context;
 
@@ -570,6 +620,7 @@ struct _GLFWwindow
         GLFWkeyfun                key;
         GLFWcharfun               character;
         GLFWcharmodsfun           charmods;
+        GLFWtextfun               text;
         GLFWdropfun               drop;
     } callbacks;
 
@@ -601,15 +652,43 @@ struct _GLFWmonitor
     GLFW_PLATFORM_MONITOR_STATE
 };
 
+// Image of one or more cursors with identical images, hotspots and native state
+//
+struct _GLFWcursorImage
+{
+    uint64_t        hash;
+    int             width, height;
+    int             xhot, yhot;
+    unsigned char*  pixels;
+    int             references;
+};
+
 // Cursor structure
 //
 struct _GLFWcursor
 {
     _GLFWcursor*    next;
+    // Image cursors created from identical images share their native cursor,
+    // which is destroyed along with the last of them
+    _GLFWcursorImage* image;
     // This is defined in platform.h
     GLFW_PLATFORM_CURSOR_STATE
 };
 
+// Timer structure
+//
+struct _GLFWtimer
+{
+    _GLFWtimer*     next;
+    // The deadline and interval are in raw timer units
+    uint64_t        deadline;
+    uint64_t        interval;
+    GLFWbool        repeat;
+    GLFWbool        active;
+    GLFWtimerfun    callback;
+    void*           userPointer;
+};
+
 // Gamepad mapping element structure
 //
 struct _GLFWmapelement
@@ -658,6 +737,27 @@ struct _GLFWtls
     GLFW_PLATFORM_TLS_STATE
 };
 
+// User event queue cell
+// The sequence number tells producers and the consumer whose turn it is
+//
+struct _GLFWuserevent
+{
+    volatile unsigned int sequence;
+    void*               payload;
+    int                 tag;
+};
+
+// File descriptor watch structure
+//
+struct _GLFWfdwatch
+{
+    int             fd;
+    int             events;
+    // The readiness found by the last platform poll, not yet dispatched
+    int             revents;
+    GLFWfdfun       callback;
+};
+
 // Mutex structure
 //
 struct _GLFWmutex
@@ -736,10 +836,14 @@ struct _GLFWplatform
     void (*setWindowFloating)(_GLFWwindow*,GLFWbool);
     void (*setWindowOpacity)(_GLFWwindow*,float);
     void (*setWindowMousePassthrough)(_GLFWwindow*,GLFWbool);
+    unsigned char* (*getWindowPixels)(_GLFWwindow*,int*);
+    void (*swapWindowPixels)(_GLFWwindow*);
+    void (*presentPixels)(_GLFWwindow*,const unsigned char*,int,int,int,const GLFWrect*);
     void (*pollEvents)(void);
     void (*waitEvents)(void);
     void (*waitEventsTimeout)(double);
     void (*postEmptyEvent)(void);
+    int (*getEventLoopFd)(void);
     // EGL
     EGLenum (*getEGLPlatform)(EGLint**);
     EGLNativeDisplayType (*getEGLNativeDisplay)(void);
@@ -769,7 +873,10 @@ struct _GLFWlibrary
 
     _GLFWerror*         errorListHead;
     _GLFWcursor*        cursorListHead;
+    _GLFWtimer*         timerListHead;
     _GLFWwindow*        windowListHead;
+    // Whether any window has damage not yet reported
+    GLFWbool            damagePending;
 
     _GLFWmonitor**      monitors;
     int                 monitorCount;
@@ -782,6 +889,10 @@ struct _GLFWlibrary
     _GLFWtls            errorSlot;
     _GLFWtls            contextSlot;
     _GLFWmutex          errorLock;
+    // Serializes loading of modules needed by functions callable from any thread
+    _GLFWmutex          moduleLock;
+    GLFWmoduletime      moduleTimes[_GLFW_MODULE_TIME_COUNT];
+    int                 moduleTimeCount;
 
     struct {
         uint64_t        offset;
@@ -861,9 +972,26 @@ struct _GLFWlibrary
         GLFWbool        KHR_wayland_surface;
     } vk;
 
+    // Bounded multiple producer, single consumer queue of user events
+    struct {
+        _GLFWuserevent  cells[_GLFW_USER_EVENT_COUNT];
+        // The next cell to be claimed by a producer
+        volatile unsigned int head;
+        // The next cell to be read by the main thread
+        unsigned int    tail;
+    } userEvents;
+
+    _GLFWfdwatch*       fdWatches;
+    int                 fdWatchCount;
+    // Whether any watched file descriptor has readiness to dispatch
+    GLFWbool            fdWatchReady;
+    // Whether the event loop file descriptor needs updating after dispatch
+    GLFWbool            eventLoopFdUsed;
+
     struct {
         GLFWmonitorfun  monitor;
         GLFWjoystickfun joystick;
+        GLFWusereventfun userEvent;
     } callbacks;
 
     // These are defined in platform.h
@@ -913,16 +1041,21 @@ void _glfwInputWindowContentScale(_GLFWwindow* window,
 void _glfwInputWindowIconify(_GLFWwindow* window, GLFWbool iconified);
 void _glfwInputWindowMaximize(_GLFWwindow* window, GLFWbool maximized);
 void _glfwInputWindowDamage(_GLFWwindow* window);
+void _glfwInputWindowDamageRect(_GLFWwindow* window,
+                                int x, int y, int width, int height);
 void _glfwInputWindowCloseRequest(_GLFWwindow* window);
 void _glfwInputWindowMonitor(_GLFWwindow* window, _GLFWmonitor* monitor);
 
 void _glfwInputKey(_GLFWwindow* window,
                    int key, int scancode, int action, int mods);
+void _glfwInputText(_GLFWwindow* window,
+                    const char* text, int mods, GLFWbool plain);
 void _glfwInputChar(_GLFWwindow* window,
                     uint32_t codepoint, int mods, GLFWbool plain);
 void _glfwInputScroll(_GLFWwindow* window, double xoffset, double yoffset);
 void _glfwInputMouseClick(_GLFWwindow* window, int button, int action, int mods);
 void _glfwInputCursorPos(_GLFWwindow* window, double xpos, double ypos);
+void _glfwInputRawMouseMotion(_GLFWwindow* window, double dx, double dy);
 void _glfwInputCursorEnter(_GLFWwindow* window, GLFWbool entered);
 void _glfwInputDrop(_GLFWwindow* window, int count, const char** names);
 void _glfwInputJoystick(_GLFWjoystick* js, int event);
@@ -972,6 +1105,11 @@ _GLFWjoystick* _glfwAllocJoystick(const char* name,
                                   int hatCount);
 void _glfwFreeJoystick(_GLFWjoystick* js);
 void _glfwCenterCursorInContentArea(_GLFWwindow* window);
+GLFWbool _glfwGetTimerTimeout(double* timeout);
+void _glfwFireTimers(void);
+void _glfwUpdateEventLoop(void);
+void _glfwRecordModuleTime(const char* name, uint64_t start);
+void _glfwLoadModuleOnce(GLFWbool* loaded, const char* name, void (*load)(void));
 
 GLFWbool _glfwInitEGL(void);
 void _glfwTerminateEGL(void);
@@ -995,7 +1133,14 @@ GLFWbool _glfwInitVulkan(int mode);
 void _glfwTerminateVulkan(void);
 const char* _glfwGetVulkanResultString(VkResult result);
 
+void _glfwConvertPixels(void* target,
+                        const unsigned char* source,
+                        size_t count,
+                        int format);
+uint64_t _glfwHashImage(const GLFWimage* image, uint64_t seed);
+
 size_t _glfwEncodeUTF8(char* s, uint32_t codepoint);
+uint32_t _glfwDecodeUTF8(const char** s);
 
 char* _glfw_strdup(const char* source);
 float _glfw_fminf(float a, float b);
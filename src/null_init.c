@@ -30,6 +30,8 @@
 #include "internal.h"
 
 #include <stdlib.h>
+#include <string.h>
+#include <errno.h>
 
 
 //////////////////////////////////////////////////////////////////////////
@@ -102,10 +104,14 @@ GLFWbool _glfwConnectNull(int platformID, _GLFWplatform* platform)
         _glfwSetWindowFloatingNull,
         _glfwSetWindowOpacityNull,
         _glfwSetWindowMousePassthroughNull,
+        _glfwGetWindowPixelsNull,
+        _glfwSwapWindowPixelsNull,
+        _glfwPresentPixelsNull,
         _glfwPollEventsNull,
         _glfwWaitEventsNull,
         _glfwWaitEventsTimeoutNull,
         _glfwPostEmptyEventNull,
+        _glfwGetEventLoopFdNull,
         _glfwGetEGLPlatformNull,
         _glfwGetEGLNativeDisplayNull,
         _glfwGetEGLNativeWindowNull,
@@ -120,12 +126,27 @@ GLFWbool _glfwConnectNull(int platformID, _GLFWplatform* platform)
 
 int _glfwInitNull(void)
 {
+#if !defined(_WIN32)
+    if (!_glfwCreateWakePOSIX(&_glfw.null.emptyEventWake))
+    {
+        _glfwInputError(GLFW_PLATFORM_ERROR,
+                        "Null: Failed to create empty event wakeup: %s",
+                        strerror(errno));
+        return GLFW_FALSE;
+    }
+#endif
+
     _glfwPollMonitorsNull();
     return GLFW_TRUE;
 }
 
 void _glfwTerminateNull(void)
 {
+#if !defined(_WIN32)
+    _glfwDestroyWakePOSIX(&_glfw.null.emptyEventWake);
+    _glfwDestroyEventLoopPOSIX(&_glfw.null.eventLoop);
+#endif
+
     free(_glfw.null.clipboardString);
     _glfwTerminateOSMesa();
     _glfwTerminateEGL();
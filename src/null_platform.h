@@ -51,6 +51,20 @@ typedef struct _GLFWwindowNull
     GLFWbool        floating;
     GLFWbool        transparent;
     float           opacity;
+    // Software framebuffer, with both buffers in a single page-aligned block
+    void*           pixelMemory;
+    size_t          pixelCapacity;
+    unsigned char*  pixels[2];
+    int             pixelWidth;
+    int             pixelHeight;
+    int             pixelStride;
+    int             backBuffer;
+    // Shared memory frame export ring, see glfwGetNullFrameExportFd
+    int             exportFd;
+    int             exportSlots;
+    void*           exportMemory;
+    size_t          exportSize;
+    PFNGLFINISHPROC Finish;
 } _GLFWwindowNull;
 
 // Null-specific per-monitor data
@@ -68,6 +82,10 @@ typedef struct _GLFWlibraryNull
     int             ycursor;
     char*           clipboardString;
     _GLFWwindow*    focusedWindow;
+#if !defined(_WIN32)
+    _GLFWwakePOSIX  emptyEventWake;
+    _GLFWeventloopPOSIX eventLoop;
+#endif
 } _GLFWlibraryNull;
 
 void _glfwPollMonitorsNull(void);
@@ -109,6 +127,9 @@ void _glfwSetWindowResizableNull(_GLFWwindow* window, GLFWbool enabled);
 void _glfwSetWindowDecoratedNull(_GLFWwindow* window, GLFWbool enabled);
 void _glfwSetWindowFloatingNull(_GLFWwindow* window, GLFWbool enabled);
 void _glfwSetWindowMousePassthroughNull(_GLFWwindow* window, GLFWbool enabled);
+unsigned char* _glfwGetWindowPixelsNull(_GLFWwindow* window, int* stride);
+void _glfwSwapWindowPixelsNull(_GLFWwindow* window);
+void _glfwPresentPixelsNull(_GLFWwindow* window, const unsigned char* pixels, int stride, int width, int height, const GLFWrect* area);
 float _glfwGetWindowOpacityNull(_GLFWwindow* window);
 void _glfwSetWindowOpacityNull(_GLFWwindow* window, float opacity);
 void _glfwSetRawMouseMotionNull(_GLFWwindow *window, GLFWbool enabled);
@@ -125,6 +146,7 @@ void _glfwPollEventsNull(void);
 void _glfwWaitEventsNull(void);
 void _glfwWaitEventsTimeoutNull(double timeout);
 void _glfwPostEmptyEventNull(void);
+int _glfwGetEventLoopFdNull(void);
 void _glfwGetCursorPosNull(_GLFWwindow* window, double* xpos, double* ypos);
 void _glfwSetCursorPosNull(_GLFWwindow* window, double x, double y);
 void _glfwSetCursorModeNull(_GLFWwindow* window, int mode);
@@ -27,9 +27,326 @@
 // It is fine to use C99 in this file because it will not be built with VS
 //========================================================================
 
+#define _GNU_SOURCE
+
 #include "internal.h"
 
+#define GLFW_EXPOSE_NATIVE_NULL
+#include "../include/GLFW/glfw3native.h"
+
 #include <stdlib.h>
+#include <string.h>
+
+#if !defined(_WIN32)
+ #include <stdio.h>
+ #include <errno.h>
+ #include <fcntl.h>
+ #include <time.h>
+ #include <unistd.h>
+ #include <sys/mman.h>
+#endif
+
+#if !defined(_WIN32)
+
+// Waits for an empty event or a watched file descriptor, or for the timeout
+// period to elapse
+//
+static void waitForEvents(double* timeout)
+{
+    struct pollfd fd = { _glfw.null.emptyEventWake.fds[0], POLLIN };
+    _glfwPollWithWatchesPOSIX(&fd, 1, timeout);
+}
+
+// Creates an anonymous shared memory file for the frame export ring
+//
+static int createExportFile(void)
+{
+#if defined(HAVE_MEMFD_CREATE)
+    return memfd_create("glfw-frames", MFD_CLOEXEC);
+#elif defined(SHM_ANON)
+    return shm_open(SHM_ANON, O_RDWR | O_CLOEXEC, 0600);
+#else
+    static unsigned int counter = 0;
+    char name[64];
+    int fd;
+
+    snprintf(name, sizeof(name), "/glfw-frames-%ld-%u",
+             (long) getpid(), counter++);
+
+    fd = shm_open(name, O_RDWR | O_CREAT | O_EXCL | O_CLOEXEC, 0600);
+    if (fd >= 0)
+        shm_unlink(name);
+
+    return fd;
+#endif
+}
+
+// Returns the specified slot of a frame export ring
+//
+static GLFWframeslot* getExportSlot(GLFWframeexport* header, unsigned int index)
+{
+    return (GLFWframeslot*) ((unsigned char*) header + header->slotOffset +
+                             header->slotSize * index);
+}
+
+// Increments the sequence numbers of every slot of a frame export ring, making
+// them odd while it is being resized and even again afterwards
+//
+static void advanceExportSlots(GLFWframeexport* header)
+{
+    unsigned int i;
+
+    for (i = 0;  i < header->slotCount;  i++)
+    {
+        GLFWframeslot* slot = getExportSlot(header, i);
+        const unsigned int sequence = slot->sequence;
+        _glfwAtomicCompareSwap(&slot->sequence, sequence, sequence + 1);
+    }
+}
+
+// Makes the frame export ring large enough for frames of the specified size
+//
+static GLFWbool resizeExport(_GLFWwindow* window, size_t pixelSize)
+{
+    const size_t pageSize = 4096;
+    const size_t slotSize = (64 + pixelSize + pageSize - 1) & ~(pageSize - 1);
+    const size_t size = pageSize + slotSize * window->null.exportSlots;
+    GLFWframeexport* header = window->null.exportMemory;
+    unsigned int sequence = 0;
+    size_t oldSlotSize = 0;
+    unsigned char* memory;
+    int i;
+
+    if (header)
+    {
+        // Tell readers that the layout is changing, both those checking the
+        // header and those only checking the slot they are reading
+        sequence = header->sequence;
+        oldSlotSize = header->slotSize;
+        _glfwAtomicCompareSwap(&header->sequence, sequence, sequence + 1);
+        advanceExportSlots(header);
+    }
+
+    // The ring only grows, so the old mapping stays valid until it is replaced
+    if (ftruncate(window->null.exportFd, size) != 0)
+    {
+        _glfwInputError(GLFW_PLATFORM_ERROR,
+                        "Null: Failed to resize frame export memory: %s",
+                        strerror(errno));
+
+        if (header)
+        {
+            advanceExportSlots(header);
+            _glfwAtomicStore(&header->sequence, sequence);
+        }
+
+        return GLFW_FALSE;
+    }
+
+    memory = mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_SHARED,
+                  window->null.exportFd, 0);
+    if (memory == MAP_FAILED)
+    {
+        _glfwInputError(GLFW_PLATFORM_ERROR,
+                        "Null: Failed to map frame export memory: %s",
+                        strerror(errno));
+
+        if (header)
+        {
+            advanceExportSlots(header);
+            _glfwAtomicStore(&header->sequence, sequence);
+        }
+
+        return GLFW_FALSE;
+    }
+
+    if (header)
+        munmap(window->null.exportMemory, window->null.exportSize);
+
+    window->null.exportMemory = memory;
+    window->null.exportSize = size;
+
+    // Carry the sequence number of each slot over to its new location, so no
+    // reader sees the same even number before and after the resize.  The slots
+    // only move to larger offsets, so walking them backwards reads every old
+    // slot header before a new one can overwrite it
+    for (i = window->null.exportSlots - 1;  i >= 0;  i--)
+    {
+        GLFWframeslot* slot = (GLFWframeslot*) (memory + pageSize + slotSize * i);
+        unsigned int slotSequence = 0;
+
+        if (header)
+        {
+            const GLFWframeslot* old = (GLFWframeslot*)
+                (memory + pageSize + oldSlotSize * i);
+            slotSequence = old->sequence + 1;
+        }
+
+        memset(slot, 0, sizeof(GLFWframeslot));
+        slot->offset = 64;
+        _glfwAtomicStore(&slot->sequence, slotSequence);
+    }
+
+    header = (GLFWframeexport*) memory;
+    header->magic = GLFW_FRAME_EXPORT_MAGIC;
+    header->version = 1;
+    header->slotCount = window->null.exportSlots;
+    header->slotOffset = (uint32_t) pageSize;
+    header->slotSize = slotSize;
+    _glfwAtomicStore(&header->sequence, sequence + 2);
+    return GLFW_TRUE;
+}
+
+// Publishes a frame to the frame export ring of the window
+// A negative stride means that the rows are stored from the bottom up
+//
+static void exportFrame(_GLFWwindow* window,
+                        const unsigned char* pixels,
+                        int width, int height, int stride)
+{
+    const size_t rowSize = (size_t) width * 4;
+    GLFWframeexport* header = window->null.exportMemory;
+    GLFWframeslot* slot;
+    unsigned char* target;
+    unsigned int frame, sequence;
+    struct timespec ts;
+    int y;
+
+    if (!header)
+        return;
+
+    if (rowSize * height > header->slotSize - 64)
+    {
+        if (!resizeExport(window, rowSize * height))
+            return;
+
+        header = window->null.exportMemory;
+    }
+
+    frame = header->frame + 1;
+    if (frame == 0)
+        frame = 1;
+
+    slot = getExportSlot(header, frame % header->slotCount);
+
+    // The compare and swap orders the odd sequence number before the pixels
+    sequence = slot->sequence;
+    _glfwAtomicCompareSwap(&slot->sequence, sequence, sequence + 1);
+
+    target = (unsigned char*) slot + slot->offset;
+
+    if (stride < 0)
+        pixels += (size_t) -stride * (height - 1);
+
+    for (y = 0;  y < height;  y++)
+        memcpy(target + rowSize * y, pixels + (ptrdiff_t) stride * y, rowSize);
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+
+    slot->frame = frame;
+    slot->width = width;
+    slot->height = height;
+    slot->stride = (uint32_t) rowSize;
+    slot->timestamp = (uint64_t) ts.tv_sec * 1000000000 + ts.tv_nsec;
+
+    _glfwAtomicStore(&slot->sequence, sequence + 2);
+    _glfwAtomicStore(&header->frame, frame);
+}
+
+// Sets up frame export for the window if it was requested
+//
+static GLFWbool createExport(_GLFWwindow* window, int slots)
+{
+    window->null.exportFd = -1;
+
+    if (!slots)
+        return GLFW_TRUE;
+
+    window->null.exportFd = createExportFile();
+    if (window->null.exportFd < 0)
+    {
+        _glfwInputError(GLFW_PLATFORM_ERROR,
+                        "Null: Failed to create frame export memory: %s",
+                        strerror(errno));
+        return GLFW_FALSE;
+    }
+
+    window->null.exportSlots = slots;
+    return resizeExport(window, (size_t) window->null.width *
+                                window->null.height * 4);
+}
+
+static void destroyExport(_GLFWwindow* window)
+{
+    if (window->null.exportMemory)
+        munmap(window->null.exportMemory, window->null.exportSize);
+
+    if (window->null.exportFd >= 0)
+        close(window->null.exportFd);
+}
+
+// Publishes the color buffer of an OSMesa context, which is otherwise not
+// double buffered
+//
+static void swapBuffersExportOSMesa(_GLFWwindow* window)
+{
+    const int width = window->context.osmesa.width;
+    const int height = window->context.osmesa.height;
+
+    if (!window->context.osmesa.buffer)
+        return;
+
+    if (_glfwPlatformGetTls(&_glfw.contextSlot) == window)
+        window->null.Finish();
+
+    // OSMesa stores rows from the bottom up
+    exportFrame(window, window->context.osmesa.buffer,
+                width, height, -width * 4);
+}
+
+#endif // _WIN32
+
+// Makes the software framebuffer match the current size of the window,
+// reusing the existing allocation whenever it is large enough
+//
+static GLFWbool resizePixels(_GLFWwindow* window)
+{
+    // Rows are aligned for vector stores and each buffer starts on a page
+    const size_t pageSize = 4096;
+    const int width = window->null.width;
+    const int height = window->null.height;
+    const int stride = (width * 4 + 63) & ~63;
+    const size_t size = ((size_t) stride * height + pageSize - 1) & ~(pageSize - 1);
+    unsigned char* base;
+
+    if (window->null.pixelMemory &&
+        window->null.pixelWidth == width &&
+        window->null.pixelHeight == height)
+    {
+        return GLFW_TRUE;
+    }
+
+    if (size * 2 > window->null.pixelCapacity)
+    {
+        _glfw_free(window->null.pixelMemory);
+        window->null.pixelCapacity = 0;
+        window->null.pixelMemory = _glfw_calloc(size * 2 + pageSize, 1);
+        if (!window->null.pixelMemory)
+            return GLFW_FALSE;
+
+        window->null.pixelCapacity = size * 2;
+    }
+
+    base = (unsigned char*)
+        (((uintptr_t) window->null.pixelMemory + pageSize - 1) & ~(uintptr_t) (pageSize - 1));
+
+    window->null.pixels[0] = base;
+    window->null.pixels[1] = base + size;
+    window->null.pixelWidth = width;
+    window->null.pixelHeight = height;
+    window->null.pixelStride = stride;
+    return GLFW_TRUE;
+}
 
 static void applySizeLimits(_GLFWwindow* window, int* width, int* height)
 {
@@ -94,6 +411,7 @@ static int createNativeWindow(_GLFWwindow* window,
     window->null.floating = wndconfig->floating;
     window->null.transparent = fbconfig->transparent;
     window->null.opacity = 1.f;
+    window->null.exportFd = -1;
 
     return GLFW_TRUE;
 }
@@ -111,6 +429,26 @@ int _glfwCreateWindowNull(_GLFWwindow* window,
     if (!createNativeWindow(window, wndconfig, fbconfig))
         return GLFW_FALSE;
 
+    if (wndconfig->null.exportSlots)
+    {
+#if defined(_WIN32)
+        _glfwInputError(GLFW_FEATURE_UNAVAILABLE,
+                        "Null: Frame export is not supported on Windows");
+        return GLFW_FALSE;
+#else
+        if (wndconfig->null.exportSlots < 0)
+        {
+            _glfwInputError(GLFW_INVALID_VALUE,
+                            "Null: Invalid frame export slot count %i",
+                            wndconfig->null.exportSlots);
+            return GLFW_FALSE;
+        }
+
+        if (!createExport(window, wndconfig->null.exportSlots))
+            return GLFW_FALSE;
+#endif
+    }
+
     if (ctxconfig->client != GLFW_NO_API)
     {
         if (ctxconfig->source == GLFW_NATIVE_CONTEXT_API ||
@@ -120,6 +458,15 @@ int _glfwCreateWindowNull(_GLFWwindow* window,
                 return GLFW_FALSE;
             if (!_glfwCreateContextOSMesa(window, ctxconfig, fbconfig))
                 return GLFW_FALSE;
+
+#if !defined(_WIN32)
+            if (window->null.exportMemory)
+            {
+                window->null.Finish = (PFNGLFINISHPROC)
+                    window->context.getProcAddress("glFinish");
+                window->context.swapBuffers = swapBuffersExportOSMesa;
+            }
+#endif
         }
         else if (ctxconfig->source == GLFW_EGL_CONTEXT_API)
         {
@@ -150,6 +497,12 @@ void _glfwDestroyWindowNull(_GLFWwindow* window)
 
     if (window->context.destroy)
         window->context.destroy(window);
+
+#if !defined(_WIN32)
+    destroyExport(window);
+#endif
+
+    _glfw_free(window->null.pixelMemory);
 }
 
 void _glfwSetWindowTitleNull(_GLFWwindow* window, const char* title)
@@ -235,6 +588,7 @@ void _glfwSetWindowSizeNull(_GLFWwindow* window, int width, int height)
         window->null.height = height;
         _glfwInputWindowSize(window, width, height);
         _glfwInputFramebufferSize(window, width, height);
+        _glfwInputWindowDamageRect(window, 0, 0, width, height);
     }
 }
 
@@ -381,6 +735,43 @@ void _glfwSetWindowMousePassthroughNull(_GLFWwindow* window, GLFWbool enabled)
 {
 }
 
+unsigned char* _glfwGetWindowPixelsNull(_GLFWwindow* window, int* stride)
+{
+    if (!resizePixels(window))
+        return NULL;
+
+    if (stride)
+        *stride = window->null.pixelStride;
+
+    return window->null.pixels[window->null.backBuffer];
+}
+
+void _glfwSwapWindowPixelsNull(_GLFWwindow* window)
+{
+    window->null.backBuffer ^= 1;
+
+#if !defined(_WIN32)
+    if (window->null.pixelMemory)
+    {
+        exportFrame(window,
+                    window->null.pixels[window->null.backBuffer ^ 1],
+                    window->null.pixelWidth,
+                    window->null.pixelHeight,
+                    window->null.pixelStride);
+    }
+#endif
+}
+
+void _glfwPresentPixelsNull(_GLFWwindow* window,
+                            const unsigned char* pixels,
+                            int stride, int width, int height,
+                            const GLFWrect* area)
+{
+#if !defined(_WIN32)
+    exportFrame(window, pixels, width, height, stride);
+#endif
+}
+
 float _glfwGetWindowOpacityNull(_GLFWwindow* window)
 {
     return window->null.opacity;
@@ -403,6 +794,8 @@ GLFWbool _glfwRawMouseMotionSupportedNull(void)
 void _glfwShowWindowNull(_GLFWwindow* window)
 {
     window->null.visible = GLFW_TRUE;
+    _glfwInputWindowDamageRect(window, 0, 0,
+                               window->null.width, window->null.height);
 }
 
 void _glfwRequestWindowAttentionNull(_GLFWwindow* window)
@@ -460,18 +853,45 @@ int _glfwWindowVisibleNull(_GLFWwindow* window)
 
 void _glfwPollEventsNull(void)
 {
+#if !defined(_WIN32)
+    _glfwDrainWakePOSIX(&_glfw.null.emptyEventWake);
+    _glfwCheckWatchesPOSIX();
+#endif
 }
 
 void _glfwWaitEventsNull(void)
 {
+#if !defined(_WIN32)
+    waitForEvents(NULL);
+#endif
+    _glfwPollEventsNull();
 }
 
 void _glfwWaitEventsTimeoutNull(double timeout)
 {
+#if !defined(_WIN32)
+    waitForEvents(&timeout);
+#endif
+    _glfwPollEventsNull();
 }
 
 void _glfwPostEmptyEventNull(void)
 {
+#if !defined(_WIN32)
+    _glfwSignalWakePOSIX(&_glfw.null.emptyEventWake);
+#endif
+}
+
+int _glfwGetEventLoopFdNull(void)
+{
+#if !defined(_WIN32)
+    const int fd = _glfw.null.emptyEventWake.fds[0];
+    return _glfwUpdateEventLoopPOSIX(&_glfw.null.eventLoop, &fd, 1, GLFW_FALSE);
+#else
+    _glfwInputError(GLFW_FEATURE_UNAVAILABLE,
+                    "Null: The event loop has no file descriptor");
+    return -1;
+#endif
 }
 
 void _glfwGetCursorPosNull(_GLFWwindow* window, double* xpos, double* ypos)
@@ -691,3 +1111,28 @@ VkResult _glfwCreateWindowSurfaceNull(VkInstance instance,
     return VK_ERROR_EXTENSION_NOT_PRESENT;
 }
 
+
+//////////////////////////////////////////////////////////////////////////
+//////                        GLFW native API                       //////
+//////////////////////////////////////////////////////////////////////////
+
+GLFWAPI int glfwGetNullFrameExportFd(GLFWwindow* handle)
+{
+    _GLFWwindow* window = (_GLFWwindow*) handle;
+    _GLFW_REQUIRE_INIT_OR_RETURN(-1);
+
+    if (_glfw.platform.platformID != GLFW_PLATFORM_NULL)
+    {
+        _glfwInputError(GLFW_PLATFORM_UNAVAILABLE, "Null: Platform not initialized");
+        return -1;
+    }
+
+#if defined(_WIN32)
+    _glfwInputError(GLFW_FEATURE_UNAVAILABLE,
+                    "Null: Frame export is not supported on Windows");
+    return -1;
+#else
+    return window->null.exportFd;
+#endif
+}
+
@@ -113,6 +113,7 @@ static int extensionSupportedOSMesa(const char* extension)
 GLFWbool _glfwInitOSMesa(void)
 {
     int i;
+    uint64_t start;
     const char* sonames[] =
     {
 #if defined(_GLFW_OSMESA_LIBRARY)
@@ -136,6 +137,8 @@ GLFWbool _glfwInitOSMesa(void)
     if (_glfw.osmesa.handle)
         return GLFW_TRUE;
 
+    start = _glfwPlatformGetTimerValue();
+
     for (i = 0;  sonames[i];  i++)
     {
         _glfw.osmesa.handle = _glfwPlatformLoadModule(sonames[i]);
@@ -178,6 +181,7 @@ GLFWbool _glfwInitOSMesa(void)
         return GLFW_FALSE;
     }
 
+    _glfwRecordModuleTime("OSMesa", start);
     return GLFW_TRUE;
 }
 
@@ -0,0 +1,327 @@
+//========================================================================
+// GLFW 3.4 - www.glfw.org
+//------------------------------------------------------------------------
+// Copyright (c) 2002-2006 Marcus Geelnard
+// Copyright (c) 2006-2018 Camilla Löwy <elmindreda@glfw.org>
+//
+// This software is provided 'as-is', without any express or implied
+// warranty. In no event will the authors be held liable for any damages
+// arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it
+// freely, subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented; you must not
+//    claim that you wrote the original software. If you use this software
+//    in a product, an acknowledgment in the product documentation would
+//    be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such, and must not
+//    be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source
+//    distribution.
+//
+//========================================================================
+// Please use C89 style variable declarations in this file because VS 2010
+//========================================================================
+
+#include "internal.h"
+
+#include <string.h>
+
+// The vector kernels are chosen at compile time, as SSE2 is part of x86-64 and
+// NEON of AArch64, while AVX2 is only used if the compiler was told to target it
+//
+#if defined(__AVX2__)
+ #include <immintrin.h>
+ #define _GLFW_SIMD_AVX2
+ #define _GLFW_SIMD_SSE2
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+ #include <emmintrin.h>
+ #define _GLFW_SIMD_SSE2
+#elif defined(__ARM_NEON) || defined(_M_ARM64)
+ #include <arm_neon.h>
+ #define _GLFW_SIMD_NEON
+#endif
+
+// Returns floor(color * alpha / 255) without a division
+//
+static unsigned char premultiply(unsigned int color, unsigned int alpha)
+{
+    const unsigned int product = color * alpha;
+    return (unsigned char) ((product + 1 + (product >> 8)) >> 8);
+}
+
+#if defined(_GLFW_SIMD_AVX2)
+
+static __m256i premultiplyAVX2(__m256i pixels)
+{
+    const __m256i zero = _mm256_setzero_si256();
+    const __m256i one = _mm256_set1_epi16(1);
+    const __m256i alphaMask = _mm256_set1_epi32((int) 0xff000000u);
+    __m256i lo = _mm256_unpacklo_epi8(pixels, zero);
+    __m256i hi = _mm256_unpackhi_epi8(pixels, zero);
+    const __m256i alo =
+        _mm256_shufflehi_epi16(_mm256_shufflelo_epi16(lo, 0xff), 0xff);
+    const __m256i ahi =
+        _mm256_shufflehi_epi16(_mm256_shufflelo_epi16(hi, 0xff), 0xff);
+
+    lo = _mm256_mullo_epi16(lo, alo);
+    hi = _mm256_mullo_epi16(hi, ahi);
+    lo = _mm256_srli_epi16(_mm256_add_epi16(_mm256_add_epi16(lo, one),
+                                            _mm256_srli_epi16(lo, 8)), 8);
+    hi = _mm256_srli_epi16(_mm256_add_epi16(_mm256_add_epi16(hi, one),
+                                            _mm256_srli_epi16(hi, 8)), 8);
+
+    // The packing is per 128-bit lane, the same as the unpacking above
+    return _mm256_or_si256(_mm256_andnot_si256(alphaMask,
+                                               _mm256_packus_epi16(lo, hi)),
+                           _mm256_and_si256(pixels, alphaMask));
+}
+
+static size_t convertAVX2(unsigned char* target,
+                          const unsigned char* source,
+                          size_t count,
+                          GLFWbool premultiplied)
+{
+    size_t i;
+    const __m256i rbMask = _mm256_set1_epi32(0x00ff00ff);
+
+    for (i = 0;  i + 8 <= count;  i += 8)
+    {
+        __m256i pixels = _mm256_loadu_si256((const __m256i*) (source + i * 4));
+        __m256i rb;
+
+        if (premultiplied)
+            pixels = premultiplyAVX2(pixels);
+
+        // Swap the red and blue bytes of each pixel
+        rb = _mm256_and_si256(pixels, rbMask);
+        rb = _mm256_or_si256(_mm256_slli_epi32(rb, 16), _mm256_srli_epi32(rb, 16));
+        pixels = _mm256_or_si256(rb, _mm256_andnot_si256(rbMask, pixels));
+
+        _mm256_storeu_si256((__m256i*) (target + i * 4), pixels);
+    }
+
+    return i;
+}
+
+#endif /*_GLFW_SIMD_AVX2*/
+
+#if defined(_GLFW_SIMD_SSE2)
+
+static __m128i premultiplySSE2(__m128i pixels)
+{
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i one = _mm_set1_epi16(1);
+    const __m128i alphaMask = _mm_set1_epi32((int) 0xff000000u);
+    __m128i lo = _mm_unpacklo_epi8(pixels, zero);
+    __m128i hi = _mm_unpackhi_epi8(pixels, zero);
+    const __m128i alo = _mm_shufflehi_epi16(_mm_shufflelo_epi16(lo, 0xff), 0xff);
+    const __m128i ahi = _mm_shufflehi_epi16(_mm_shufflelo_epi16(hi, 0xff), 0xff);
+
+    // Each product fits in 16 bits, as does the rounding term added to it
+    lo = _mm_mullo_epi16(lo, alo);
+    hi = _mm_mullo_epi16(hi, ahi);
+    lo = _mm_srli_epi16(_mm_add_epi16(_mm_add_epi16(lo, one),
+                                      _mm_srli_epi16(lo, 8)), 8);
+    hi = _mm_srli_epi16(_mm_add_epi16(_mm_add_epi16(hi, one),
+                                      _mm_srli_epi16(hi, 8)), 8);
+
+    return _mm_or_si128(_mm_andnot_si128(alphaMask, _mm_packus_epi16(lo, hi)),
+                        _mm_and_si128(pixels, alphaMask));
+}
+
+static size_t convertSSE2(unsigned char* target,
+                          const unsigned char* source,
+                          size_t count,
+                          GLFWbool premultiplied)
+{
+    size_t i;
+    const __m128i rbMask = _mm_set1_epi32(0x00ff00ff);
+
+    for (i = 0;  i + 4 <= count;  i += 4)
+    {
+        __m128i pixels = _mm_loadu_si128((const __m128i*) (source + i * 4));
+        __m128i rb;
+
+        if (premultiplied)
+            pixels = premultiplySSE2(pixels);
+
+        // Swap the red and blue bytes of each pixel
+        rb = _mm_and_si128(pixels, rbMask);
+        rb = _mm_or_si128(_mm_slli_epi32(rb, 16), _mm_srli_epi32(rb, 16));
+        pixels = _mm_or_si128(rb, _mm_andnot_si128(rbMask, pixels));
+
+        _mm_storeu_si128((__m128i*) (target + i * 4), pixels);
+    }
+
+    return i;
+}
+
+#endif /*_GLFW_SIMD_SSE2*/
+
+#if defined(_GLFW_SIMD_NEON)
+
+static uint8x16_t premultiplyNEON(uint8x16_t color, uint8x16_t alpha)
+{
+    const uint16x8_t one = vdupq_n_u16(1);
+    uint16x8_t lo = vmull_u8(vget_low_u8(color), vget_low_u8(alpha));
+    uint16x8_t hi = vmull_u8(vget_high_u8(color), vget_high_u8(alpha));
+
+    lo = vaddq_u16(vaddq_u16(lo, one), vshrq_n_u16(lo, 8));
+    hi = vaddq_u16(vaddq_u16(hi, one), vshrq_n_u16(hi, 8));
+
+    return vcombine_u8(vshrn_n_u16(lo, 8), vshrn_n_u16(hi, 8));
+}
+
+static size_t convertNEON(unsigned char* target,
+                          const unsigned char* source,
+                          size_t count,
+                          GLFWbool premultiplied)
+{
+    size_t i;
+
+    for (i = 0;  i + 16 <= count;  i += 16)
+    {
+        // The loads and stores separate the channels, so the swizzle is free
+        const uint8x16x4_t rgba = vld4q_u8(source + i * 4);
+        uint8x16x4_t bgra;
+
+        bgra.val[0] = rgba.val[2];
+        bgra.val[1] = rgba.val[1];
+        bgra.val[2] = rgba.val[0];
+        bgra.val[3] = rgba.val[3];
+
+        if (premultiplied)
+        {
+            bgra.val[0] = premultiplyNEON(bgra.val[0], bgra.val[3]);
+            bgra.val[1] = premultiplyNEON(bgra.val[1], bgra.val[3]);
+            bgra.val[2] = premultiplyNEON(bgra.val[2], bgra.val[3]);
+        }
+
+        vst4q_u8(target + i * 4, bgra);
+    }
+
+    return i;
+}
+
+#endif /*_GLFW_SIMD_NEON*/
+
+
+//////////////////////////////////////////////////////////////////////////
+//////                       GLFW internal API                      //////
+//////////////////////////////////////////////////////////////////////////
+
+// Converts RGBA pixels, as used by GLFWimage, to the specified format
+//
+void _glfwConvertPixels(void* target,
+                        const unsigned char* source,
+                        size_t count,
+                        int format)
+{
+    const GLFWbool premultiplied = (format & _GLFW_PIXELS_PREMULTIPLIED) != 0;
+    const unsigned int one = 1;
+    size_t i = 0;
+
+    // On little-endian machines a 32-bit ARGB word is stored as BGRA bytes
+    if ((format & _GLFW_PIXELS_BGRA) || *(const unsigned char*) &one)
+    {
+        unsigned char* bytes = target;
+
+#if defined(_GLFW_SIMD_AVX2)
+        i = convertAVX2(bytes, source, count, premultiplied);
+#endif
+#if defined(_GLFW_SIMD_SSE2)
+        i += convertSSE2(bytes + i * 4, source + i * 4, count - i, premultiplied);
+#elif defined(_GLFW_SIMD_NEON)
+        i = convertNEON(bytes, source, count, premultiplied);
+#endif
+
+        for (;  i < count;  i++)
+        {
+            const unsigned char* s = source + i * 4;
+            unsigned char* t = bytes + i * 4;
+
+            if (premultiplied)
+            {
+                t[0] = premultiply(s[2], s[3]);
+                t[1] = premultiply(s[1], s[3]);
+                t[2] = premultiply(s[0], s[3]);
+            }
+            else
+            {
+                t[0] = s[2];
+                t[1] = s[1];
+                t[2] = s[0];
+            }
+
+            t[3] = s[3];
+        }
+    }
+    else
+    {
+        uint32_t* words = target;
+
+        for (;  i < count;  i++)
+        {
+            const unsigned char* s = source + i * 4;
+
+            if (premultiplied)
+            {
+                words[i] = ((uint32_t) s[3] << 24) |
+                           ((uint32_t) premultiply(s[0], s[3]) << 16) |
+                           ((uint32_t) premultiply(s[1], s[3]) << 8) |
+                           ((uint32_t) premultiply(s[2], s[3]));
+            }
+            else
+            {
+                words[i] = ((uint32_t) s[3] << 24) | ((uint32_t) s[0] << 16) |
+                           ((uint32_t) s[1] << 8) | ((uint32_t) s[2]);
+            }
+        }
+    }
+}
+
+// Returns a hash of the size and pixels of the image, for finding identical
+// images without comparing all their pixels
+//
+uint64_t _glfwHashImage(const GLFWimage* image, uint64_t seed)
+{
+    const uint64_t prime = 0x9e3779b97f4a7c15u;
+    const size_t size = (size_t) image->width * image->height * 4;
+    const unsigned char* pixels = image->pixels;
+    uint64_t lanes[4], words[4], hash;
+    size_t i;
+    int j;
+
+    for (j = 0;  j < 4;  j++)
+        lanes[j] = seed + j;
+
+    // Four independent lanes keep the multiplier busy
+    for (i = 0;  i + sizeof(words) <= size;  i += sizeof(words))
+    {
+        memcpy(words, pixels + i, sizeof(words));
+
+        for (j = 0;  j < 4;  j++)
+        {
+            lanes[j] = (lanes[j] ^ words[j]) * prime;
+            lanes[j] ^= lanes[j] >> 29;
+        }
+    }
+
+    for (;  i < size;  i++)
+        lanes[0] = (lanes[0] ^ pixels[i]) * prime;
+
+    hash = seed ^ ((uint64_t) image->width << 32) ^ (uint64_t) image->height;
+
+    for (j = 0;  j < 4;  j++)
+    {
+        hash = (hash ^ lanes[j]) * prime;
+        hash ^= hash >> 32;
+    }
+
+    return hash;
+}
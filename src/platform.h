@@ -25,6 +25,12 @@
 //
 //========================================================================
 
+// The event waiting code is shared between all backends on Unix-like systems,
+// including the null backend
+#if !defined(_WIN32)
+ #include "posix_poll.h"
+#endif
+
 #include "null_platform.h"
 
 #if defined(_GLFW_WIN32)
@@ -33,6 +33,15 @@
 #include <signal.h>
 #include <time.h>
 #include <errno.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <string.h>
+
+#if defined(__linux__)
+ #include <sys/eventfd.h>
+ #include <sys/epoll.h>
+ #include <sys/timerfd.h>
+#endif
 
 GLFWbool _glfwPollPOSIX(struct pollfd* fds, nfds_t count, double* timeout)
 {
@@ -79,3 +88,326 @@ GLFWbool _glfwPollPOSIX(struct pollfd* fds, nfds_t count, double* timeout)
     }
 }
 
+// Polls the specified file descriptors together with those watched by the
+// application, storing the readiness of the latter for dispatch
+//
+GLFWbool _glfwPollWithWatchesPOSIX(struct pollfd* fds, nfds_t count, double* timeout)
+{
+    if (!_glfw.fdWatchCount)
+        return _glfwPollPOSIX(fds, count, timeout);
+
+    struct pollfd stackFds[16];
+    struct pollfd* allFds = stackFds;
+    const nfds_t total = count + _glfw.fdWatchCount;
+
+    if (total > sizeof(stackFds) / sizeof(stackFds[0]))
+    {
+        allFds = _glfw_calloc(total, sizeof(struct pollfd));
+        if (!allFds)
+            return _glfwPollPOSIX(fds, count, timeout);
+    }
+
+    if (count)
+        memcpy(allFds, fds, count * sizeof(struct pollfd));
+
+    for (int i = 0; i < _glfw.fdWatchCount; i++)
+    {
+        const _GLFWfdwatch* watch = _glfw.fdWatches + i;
+        struct pollfd* fd = allFds + count + i;
+
+        fd->fd = watch->fd;
+        fd->events = 0;
+        fd->revents = 0;
+
+        if (watch->events & GLFW_FD_READ)
+            fd->events |= POLLIN;
+        if (watch->events & GLFW_FD_WRITE)
+            fd->events |= POLLOUT;
+    }
+
+    const GLFWbool result = _glfwPollPOSIX(allFds, total, timeout);
+
+    for (nfds_t i = 0; i < count; i++)
+        fds[i].revents = allFds[i].revents;
+
+    for (int i = 0; i < _glfw.fdWatchCount; i++)
+    {
+        const short revents = result ? allFds[count + i].revents : 0;
+        _GLFWfdwatch* watch = _glfw.fdWatches + i;
+
+        watch->revents = 0;
+        if (revents & POLLIN)
+            watch->revents |= GLFW_FD_READ;
+        if (revents & POLLOUT)
+            watch->revents |= GLFW_FD_WRITE;
+        if (revents & (POLLERR | POLLHUP | POLLNVAL))
+            watch->revents |= GLFW_FD_ERROR;
+
+        if (watch->revents)
+            _glfw.fdWatchReady = GLFW_TRUE;
+    }
+
+    if (allFds != stackFds)
+        _glfw_free(allFds);
+
+    return result;
+}
+
+// Checks the file descriptors watched by the application without blocking
+//
+void _glfwCheckWatchesPOSIX(void)
+{
+    if (_glfw.fdWatchCount)
+    {
+        double timeout = 0.0;
+        _glfwPollWithWatchesPOSIX(NULL, 0, &timeout);
+    }
+}
+
+// Creates the wakeup file descriptors without assuming the OS has pipe2(2)
+//
+GLFWbool _glfwCreateWakePOSIX(_GLFWwakePOSIX* wake)
+{
+    wake->pending = GLFW_FALSE;
+
+#if defined(__linux__)
+    wake->fds[0] = eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK);
+    if (wake->fds[0] == -1)
+    {
+        wake->fds[0] = 0;
+        return GLFW_FALSE;
+    }
+
+    wake->fds[1] = wake->fds[0];
+    return GLFW_TRUE;
+#else
+    if (pipe(wake->fds) != 0)
+    {
+        wake->fds[0] = wake->fds[1] = 0;
+        return GLFW_FALSE;
+    }
+
+    for (int i = 0; i < 2; i++)
+    {
+        const int sf = fcntl(wake->fds[i], F_GETFL, 0);
+        const int df = fcntl(wake->fds[i], F_GETFD, 0);
+
+        if (sf == -1 || df == -1 ||
+            fcntl(wake->fds[i], F_SETFL, sf | O_NONBLOCK) == -1 ||
+            fcntl(wake->fds[i], F_SETFD, df | FD_CLOEXEC) == -1)
+        {
+            return GLFW_FALSE;
+        }
+    }
+
+    return GLFW_TRUE;
+#endif
+}
+
+void _glfwDestroyWakePOSIX(_GLFWwakePOSIX* wake)
+{
+    if (wake->fds[1] && wake->fds[1] != wake->fds[0])
+        close(wake->fds[1]);
+    if (wake->fds[0])
+        close(wake->fds[0]);
+
+    wake->fds[0] = wake->fds[1] = 0;
+}
+
+// Makes the read end readable unless a wakeup is already pending, so any number
+// of signals between two drains costs a single write
+//
+void _glfwSignalWakePOSIX(_GLFWwakePOSIX* wake)
+{
+    if (__atomic_exchange_n(&wake->pending, GLFW_TRUE, __ATOMIC_ACQ_REL))
+        return;
+
+    for (;;)
+    {
+#if defined(__linux__)
+        const uint64_t value = 1;
+#else
+        const char value = 0;
+#endif
+        const ssize_t result = write(wake->fds[1], &value, sizeof(value));
+        if (result == sizeof(value) || (result == -1 && errno != EINTR))
+            break;
+    }
+}
+
+// Consumes any pending wakeup
+//
+void _glfwDrainWakePOSIX(_GLFWwakePOSIX* wake)
+{
+    for (;;)
+    {
+        char buffer[64];
+        const ssize_t result = read(wake->fds[0], buffer, sizeof(buffer));
+        if (result == -1 && errno != EINTR)
+            break;
+#if defined(__linux__)
+        if (result > 0)
+            break;
+#endif
+    }
+
+    // NOTE: The flag is cleared only after reading, as a signal between the two
+    //       can be skipped while the caller is about to process events anyway
+    __atomic_store_n(&wake->pending, GLFW_FALSE, __ATOMIC_RELEASE);
+}
+
+#if defined(__linux__)
+
+// Adds the specified file descriptor to the set, or merges its events
+//
+static void addEventLoopFd(_GLFWeventloopfdPOSIX* fds, int* count,
+                           int fd, unsigned int events)
+{
+    if (fd < 0)
+        return;
+
+    for (int i = 0; i < *count; i++)
+    {
+        if (fds[i].fd == fd)
+        {
+            fds[i].events |= events;
+            return;
+        }
+    }
+
+    fds[*count].fd = fd;
+    fds[*count].events = events;
+    (*count)++;
+}
+
+#endif // __linux__
+
+// Creates the event loop file descriptor if needed, brings its set of file
+// descriptors up to date and arms its timer for pending work and GLFW timers
+//
+int _glfwUpdateEventLoopPOSIX(_GLFWeventloopPOSIX* loop,
+                              const int* fds, int count, GLFWbool pending)
+{
+#if defined(__linux__)
+    if (!loop->epoll)
+    {
+        loop->epoll = epoll_create1(EPOLL_CLOEXEC);
+        if (loop->epoll == -1)
+        {
+            loop->epoll = 0;
+            _glfwInputError(GLFW_PLATFORM_ERROR,
+                            "POSIX: Failed to create epoll instance: %s",
+                            strerror(errno));
+            return -1;
+        }
+
+        loop->timerfd = timerfd_create(CLOCK_MONOTONIC, TFD_CLOEXEC | TFD_NONBLOCK);
+        if (loop->timerfd == -1)
+        {
+            _glfwInputError(GLFW_PLATFORM_ERROR,
+                            "POSIX: Failed to create event loop timer: %s",
+                            strerror(errno));
+            _glfwDestroyEventLoopPOSIX(loop);
+            return -1;
+        }
+    }
+
+    _GLFWeventloopfdPOSIX* wanted =
+        _glfw_calloc(count + _glfw.fdWatchCount + 1, sizeof(_GLFWeventloopfdPOSIX));
+    if (!wanted)
+        return -1;
+
+    int wantedCount = 0;
+
+    addEventLoopFd(wanted, &wantedCount, loop->timerfd, EPOLLIN);
+
+    for (int i = 0; i < count; i++)
+        addEventLoopFd(wanted, &wantedCount, fds[i], EPOLLIN);
+
+    for (int i = 0; i < _glfw.fdWatchCount; i++)
+    {
+        const _GLFWfdwatch* watch = _glfw.fdWatches + i;
+        unsigned int events = 0;
+
+        if (watch->events & GLFW_FD_READ)
+            events |= EPOLLIN;
+        if (watch->events & GLFW_FD_WRITE)
+            events |= EPOLLOUT;
+
+        addEventLoopFd(wanted, &wantedCount, watch->fd, events);
+    }
+
+    // NOTE: Errors are ignored when removing, as the application may already
+    //       have closed a file descriptor it watched
+    for (int i = 0; i < loop->fdCount; i++)
+    {
+        int j;
+
+        for (j = 0; j < wantedCount; j++)
+        {
+            if (wanted[j].fd == loop->fds[i].fd)
+                break;
+        }
+
+        if (j == wantedCount)
+            epoll_ctl(loop->epoll, EPOLL_CTL_DEL, loop->fds[i].fd, NULL);
+    }
+
+    for (int i = 0; i < wantedCount; i++)
+    {
+        struct epoll_event event = { wanted[i].events };
+        int j;
+
+        event.data.fd = wanted[i].fd;
+
+        for (j = 0; j < loop->fdCount; j++)
+        {
+            if (loop->fds[j].fd == wanted[i].fd)
+                break;
+        }
+
+        if (j == loop->fdCount)
+            epoll_ctl(loop->epoll, EPOLL_CTL_ADD, wanted[i].fd, &event);
+        else if (loop->fds[j].events != wanted[i].events)
+            epoll_ctl(loop->epoll, EPOLL_CTL_MOD, wanted[i].fd, &event);
+    }
+
+    _glfw_free(loop->fds);
+    loop->fds = wanted;
+    loop->fdCount = wantedCount;
+
+    // NOTE: Re-arming the timer also resets its readiness
+    struct itimerspec timer = {0};
+    double timeout;
+
+    if (pending)
+        timer.it_value.tv_nsec = 1;
+    else if (_glfwGetTimerTimeout(&timeout))
+    {
+        timer.it_value.tv_sec = (time_t) timeout;
+        timer.it_value.tv_nsec = (long) ((timeout - timer.it_value.tv_sec) * 1e9);
+
+        // A zero value would disarm the timer instead
+        if (!timer.it_value.tv_sec && !timer.it_value.tv_nsec)
+            timer.it_value.tv_nsec = 1;
+    }
+
+    timerfd_settime(loop->timerfd, 0, &timer, NULL);
+    return loop->epoll;
+#else
+    _glfwInputError(GLFW_FEATURE_UNAVAILABLE,
+                    "POSIX: The event loop file descriptor requires epoll");
+    return -1;
+#endif
+}
+
+void _glfwDestroyEventLoopPOSIX(_GLFWeventloopPOSIX* loop)
+{
+    if (loop->timerfd > 0)
+        close(loop->timerfd);
+    if (loop->epoll > 0)
+        close(loop->epoll);
+
+    _glfw_free(loop->fds);
+    memset(loop, 0, sizeof(_GLFWeventloopPOSIX));
+}
@@ -28,5 +28,45 @@
 
 #include <poll.h>
 
+// Cross-thread wakeup for event waits
+// The read and write ends are the same eventfd where available
+//
+typedef struct _GLFWwakePOSIX
+{
+    int             fds[2];
+    // Whether a wakeup has been signaled but not yet drained
+    int             pending;
+} _GLFWwakePOSIX;
+
+// Registered file descriptor of the event loop file descriptor
+//
+typedef struct _GLFWeventloopfdPOSIX
+{
+    int             fd;
+    unsigned int    events;
+} _GLFWeventloopfdPOSIX;
+
+// Single pollable file descriptor aggregating all event sources
+// This is an epoll instance plus a timerfd for pending work and GLFW timers
+//
+typedef struct _GLFWeventloopPOSIX
+{
+    int             epoll;
+    int             timerfd;
+    _GLFWeventloopfdPOSIX* fds;
+    int             fdCount;
+} _GLFWeventloopPOSIX;
+
 GLFWbool _glfwPollPOSIX(struct pollfd* fds, nfds_t count, double* timeout);
+GLFWbool _glfwPollWithWatchesPOSIX(struct pollfd* fds, nfds_t count, double* timeout);
+void _glfwCheckWatchesPOSIX(void);
+
+GLFWbool _glfwCreateWakePOSIX(_GLFWwakePOSIX* wake);
+void _glfwDestroyWakePOSIX(_GLFWwakePOSIX* wake);
+void _glfwSignalWakePOSIX(_GLFWwakePOSIX* wake);
+void _glfwDrainWakePOSIX(_GLFWwakePOSIX* wake);
+
+int _glfwUpdateEventLoopPOSIX(_GLFWeventloopPOSIX* loop,
+                              const int* fds, int count, GLFWbool pending);
+void _glfwDestroyEventLoopPOSIX(_GLFWeventloopPOSIX* loop);
 
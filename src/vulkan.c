@@ -37,20 +37,15 @@
 #define _GLFW_REQUIRE_LOADER 2
 
 
-//////////////////////////////////////////////////////////////////////////
-//////                       GLFW internal API                      //////
-//////////////////////////////////////////////////////////////////////////
-
-GLFWbool _glfwInitVulkan(int mode)
+// Loads the Vulkan loader and queries the instance extensions it supports
+//
+static GLFWbool loadVulkan(int mode)
 {
     VkResult err;
     VkExtensionProperties* ep;
     PFN_vkEnumerateInstanceExtensionProperties vkEnumerateInstanceExtensionProperties;
     uint32_t i, count;
 
-    if (_glfw.vk.available)
-        return GLFW_TRUE;
-
     if (_glfw.hints.init.vulkanLoader)
         _glfw.vk.GetInstanceProcAddr = _glfw.hints.init.vulkanLoader;
     else
@@ -148,13 +143,41 @@ GLFWbool _glfwInitVulkan(int mode)
 
     _glfw_free(ep);
 
-    _glfw.vk.available = GLFW_TRUE;
-
     _glfw.platform.getRequiredInstanceExtensions(_glfw.vk.extensions);
 
     return GLFW_TRUE;
 }
 
+
+//////////////////////////////////////////////////////////////////////////
+//////                       GLFW internal API                      //////
+//////////////////////////////////////////////////////////////////////////
+
+GLFWbool _glfwInitVulkan(int mode)
+{
+    GLFWbool loaded = GLFW_FALSE, available;
+    uint64_t start = 0;
+
+    // The Vulkan functions may be called from any thread, so loading is
+    // serialized, and a missing loader is looked for again on the next call
+    _glfwPlatformLockMutex(&_glfw.moduleLock);
+
+    if (!_glfw.vk.available)
+    {
+        start = _glfwPlatformGetTimerValue();
+        loaded = _glfw.vk.available = loadVulkan(mode);
+    }
+
+    available = _glfw.vk.available;
+
+    _glfwPlatformUnlockMutex(&_glfw.moduleLock);
+
+    if (loaded)
+        _glfwRecordModuleTime("Vulkan", start);
+
+    return available;
+}
+
 void _glfwTerminateVulkan(void)
 {
     if (_glfw.vk.handle)
@@ -99,14 +99,12 @@ static const GLFWimage* chooseImage(int count, const GLFWimage* images,
 //
 static HICON createIcon(const GLFWimage* image, int xhot, int yhot, GLFWbool icon)
 {
-    int i;
     HDC dc;
     HICON handle;
     HBITMAP color, mask;
     BITMAPV5HEADER bi;
     ICONINFO ii;
     unsigned char* target = NULL;
-    unsigned char* source = image->pixels;
 
     ZeroMemory(&bi, sizeof(bi));
     bi.bV5Size        = sizeof(bi);
@@ -145,15 +143,9 @@ static HICON createIcon(const GLFWimage* image, int xhot, int yhot, GLFWbool ico
         return NULL;
     }
 
-    for (i = 0;  i < image->width * image->height;  i++)
-    {
-        target[0] = source[2];
-        target[1] = source[1];
-        target[2] = source[0];
-        target[3] = source[3];
-        target += 4;
-        source += 4;
-    }
+    _glfwConvertPixels(target, image->pixels,
+                       (size_t) image->width * image->height,
+                       _GLFW_PIXELS_BGRA);
 
     ZeroMemory(&ii, sizeof(ii));
     ii.fIcon    = icon;
@@ -961,9 +953,7 @@ static LRESULT CALLBACK windowProc(HWND hWnd, UINT uMsg, WPARAM wParam, LPARAM l
                 dy = data->data.mouse.lLastY;
             }
 
-            _glfwInputCursorPos(window,
-                                window->virtualCursorPosX + dx,
-                                window->virtualCursorPosY + dy);
+            _glfwInputRawMouseMotion(window, dx, dy);
 
             window->win32.lastCursorPosX += dx;
             window->win32.lastCursorPosY += dy;
@@ -1975,6 +1965,26 @@ void _glfwSetWindowMousePassthroughWin32(_GLFWwindow* window, GLFWbool enabled)
         SetLayeredWindowAttributes(window->win32.handle, key, alpha, flags);
 }
 
+unsigned char* _glfwGetWindowPixelsWin32(_GLFWwindow* window, int* stride)
+{
+    _glfwInputError(GLFW_FEATURE_UNAVAILABLE,
+                    "Win32: Software framebuffers are not supported");
+    return NULL;
+}
+
+void _glfwSwapWindowPixelsWin32(_GLFWwindow* window)
+{
+}
+
+void _glfwPresentPixelsWin32(_GLFWwindow* window,
+                             const unsigned char* pixels,
+                             int stride, int width, int height,
+                             const GLFWrect* area)
+{
+    _glfwInputError(GLFW_FEATURE_UNAVAILABLE,
+                    "Win32: Software presentation is not supported");
+}
+
 float _glfwGetWindowOpacityWin32(_GLFWwindow* window)
 {
     BYTE alpha;
@@ -2128,6 +2138,13 @@ void _glfwPostEmptyEventWin32(void)
     PostMessageW(_glfw.win32.helperWindowHandle, WM_NULL, 0, 0);
 }
 
+int _glfwGetEventLoopFdWin32(void)
+{
+    _glfwInputError(GLFW_FEATURE_UNAVAILABLE,
+                    "Win32: The event loop has no file descriptor");
+    return -1;
+}
+
 void _glfwGetCursorPosWin32(_GLFWwindow* window, double* xpos, double* ypos)
 {
     POINT pos;
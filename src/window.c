@@ -36,6 +36,166 @@
 #include <float.h>
 
 
+// Returns whether the outer rectangle fully contains the inner one
+//
+static GLFWbool containsRect(const GLFWrect* outer, const GLFWrect* inner)
+{
+    return inner->x >= outer->x &&
+           inner->y >= outer->y &&
+           inner->x + inner->width <= outer->x + outer->width &&
+           inner->y + inner->height <= outer->y + outer->height;
+}
+
+// Returns the bounding rectangle of the two specified rectangles
+//
+static GLFWrect mergeRects(const GLFWrect* a, const GLFWrect* b)
+{
+    const int right = a->x + a->width > b->x + b->width ?
+                      a->x + a->width : b->x + b->width;
+    const int bottom = a->y + a->height > b->y + b->height ?
+                       a->y + a->height : b->y + b->height;
+    GLFWrect result;
+
+    result.x = a->x < b->x ? a->x : b->x;
+    result.y = a->y < b->y ? a->y : b->y;
+    result.width = right - result.x;
+    result.height = bottom - result.y;
+    return result;
+}
+
+// Reports the damage accumulated during event processing, once per window
+//
+static void flushWindowDamage(void)
+{
+    _GLFWwindow* window;
+
+    if (!_glfw.damagePending)
+        return;
+
+    _glfw.damagePending = GLFW_FALSE;
+
+    window = _glfw.windowListHead;
+    while (window)
+    {
+        if (!window->damageCount)
+        {
+            window = window->next;
+            continue;
+        }
+
+        memcpy(window->reportedDamage, window->damage,
+               window->damageCount * sizeof(GLFWrect));
+        window->reportedDamageCount = window->damageCount;
+        window->damageCount = 0;
+
+        if (window->callbacks.refresh)
+        {
+            window->callbacks.refresh((GLFWwindow*) window);
+
+            // The callback may have destroyed any window, so start over
+            window = _glfw.windowListHead;
+        }
+        else
+            window = window->next;
+    }
+}
+
+// Delivers the user events posted so far to the user event callback
+//
+static void drainUserEvents(void)
+{
+    const unsigned int mask = _GLFW_USER_EVENT_COUNT - 1;
+    int count;
+
+    // NOTE: Events posted by the callback itself may keep the queue from ever
+    //       becoming empty, so at most one queue worth is delivered per call
+    for (count = 0;  count < _GLFW_USER_EVENT_COUNT;  count++)
+    {
+        const unsigned int tail = _glfw.userEvents.tail;
+        _GLFWuserevent* cell = _glfw.userEvents.cells + (tail & mask);
+        void* payload;
+        int tag;
+
+        if (_glfwAtomicLoad(&cell->sequence) != tail + 1)
+            return;
+
+        payload = cell->payload;
+        tag = cell->tag;
+
+        // Hand the cell back to producers before calling out
+        _glfwAtomicStore(&cell->sequence, tail + _GLFW_USER_EVENT_COUNT);
+        _glfw.userEvents.tail = tail + 1;
+
+        if (_glfw.callbacks.userEvent)
+            _glfw.callbacks.userEvent(payload, tag);
+    }
+
+    // Make sure the next wait does not block on the remaining events
+    _glfw.platform.postEmptyEvent();
+}
+
+// Calls the callbacks of the watched file descriptors found ready
+//
+static void dispatchFdWatches(void)
+{
+    int i = 0;
+
+    if (!_glfw.fdWatchReady)
+        return;
+
+    _glfw.fdWatchReady = GLFW_FALSE;
+
+    while (i < _glfw.fdWatchCount)
+    {
+        _GLFWfdwatch* watch = _glfw.fdWatches + i;
+        const int fd = watch->fd;
+        const int revents = watch->revents;
+
+        if (!revents)
+        {
+            i++;
+            continue;
+        }
+
+        watch->revents = 0;
+
+        if (watch->callback)
+        {
+            watch->callback(fd, revents);
+
+            // The callback may have changed the watches, so start over
+            i = 0;
+        }
+    }
+}
+
+// Returns whether the current platform supports file descriptor watches
+//
+static GLFWbool fdWatchesSupported(void)
+{
+#if defined(_WIN32)
+    return GLFW_FALSE;
+#else
+    return _glfw.platform.platformID == GLFW_PLATFORM_X11 ||
+           _glfw.platform.platformID == GLFW_PLATFORM_WAYLAND ||
+           _glfw.platform.platformID == GLFW_PLATFORM_NULL;
+#endif
+}
+
+// Delivers the events that shared code collects during event processing
+//
+static void dispatchDeferredEvents(void)
+{
+    flushWindowDamage();
+    dispatchFdWatches();
+    drainUserEvents();
+    _glfwFireTimers();
+
+    // Re-arm for any remaining work and the next timer
+    _glfwUpdateEventLoop();
+}
+
+
 //////////////////////////////////////////////////////////////////////////
 //////                         GLFW event API                       //////
 //////////////////////////////////////////////////////////////////////////
@@ -120,14 +280,82 @@ void _glfwInputWindowContentScale(_GLFWwindow* window, float xscale, float yscal
         window->callbacks.scale((GLFWwindow*) window, xscale, yscale);
 }
 
-// Notifies shared code that the window contents needs updating
+// Notifies shared code that the whole window contents needs updating now
 //
 void _glfwInputWindowDamage(_GLFWwindow* window)
 {
+    GLFWrect* rect = window->reportedDamage;
+
+    rect->x = 0;
+    rect->y = 0;
+    _glfw.platform.getWindowSize(window, &rect->width, &rect->height);
+    window->reportedDamageCount = 1;
+    window->damageCount = 0;
+
     if (window->callbacks.refresh)
         window->callbacks.refresh((GLFWwindow*) window);
 }
 
+// Notifies shared code that an area of the window contents needs updating
+// The damage is reported at the end of the current event processing
+//
+void _glfwInputWindowDamageRect(_GLFWwindow* window,
+                                int x, int y, int width, int height)
+{
+    GLFWrect rect;
+    GLFWrect* best = NULL;
+    double bestGrowth = 0.0;
+    int i;
+
+    if (width <= 0 || height <= 0)
+        return;
+
+    rect.x = x;
+    rect.y = y;
+    rect.width = width;
+    rect.height = height;
+
+    for (i = 0;  i < window->damageCount;  i++)
+    {
+        if (containsRect(window->damage + i, &rect))
+            return;
+    }
+
+    for (i = 0;  i < window->damageCount;  )
+    {
+        if (containsRect(&rect, window->damage + i))
+            window->damage[i] = window->damage[--window->damageCount];
+        else
+            i++;
+    }
+
+    _glfw.damagePending = GLFW_TRUE;
+
+    if (window->damageCount < _GLFW_DAMAGE_RECT_COUNT)
+    {
+        window->damage[window->damageCount++] = rect;
+        return;
+    }
+
+    // Merge into the rectangle whose bounds would grow the least
+    for (i = 0;  i < window->damageCount;  i++)
+    {
+        GLFWrect* target = window->damage + i;
+        const GLFWrect merged = mergeRects(target, &rect);
+        const double growth =
+            (double) merged.width * merged.height -
+            (double) target->width * target->height;
+
+        if (!best || growth < bestGrowth)
+        {
+            best = target;
+            bestGrowth = growth;
+        }
+    }
+
+    *best = mergeRects(best, &rect);
+}
+
 // Notifies shared code that the user wishes to close a window
 //
 void _glfwInputWindowCloseRequest(_GLFWwindow* window)
@@ -186,6 +414,21 @@ GLFWAPI GLFWwindow* glfwCreateWindow(int width, int height,
     if (!_glfwIsValidContextConfig(&ctxconfig))
         return NULL;
 
+    if (wndconfig.softwareFramebuffer && ctxconfig.client != GLFW_NO_API)
+    {
+        _glfwInputError(GLFW_INVALID_VALUE,
+                        "Software framebuffers require a window without an OpenGL or OpenGL ES context");
+        return NULL;
+    }
+
+    if (wndconfig.softwareFramebuffer &&
+        _glfw.platform.platformID != GLFW_PLATFORM_NULL)
+    {
+        _glfwInputError(GLFW_FEATURE_UNAVAILABLE,
+                        "Software framebuffers are not supported by this platform");
+        return NULL;
+    }
+
     window = _glfw_calloc(1, sizeof(_GLFWwindow));
     window->next = _glfw.windowListHead;
     _glfw.windowListHead = window;
@@ -204,7 +447,9 @@ GLFWAPI GLFWwindow* glfwCreateWindow(int width, int height,
     window->floating         = wndconfig.floating;
     window->focusOnShow      = wndconfig.focusOnShow;
     window->mousePassthrough = wndconfig.mousePassthrough;
+    window->softwareFramebuffer = wndconfig.softwareFramebuffer;
     window->cursorMode       = GLFW_CURSOR_NORMAL;
+    window->rawMouseMotionEvents = GLFW_TRUE;
 
     window->doublebuffer = fbconfig.doublebuffer;
 
@@ -372,6 +617,9 @@ GLFWAPI void glfwWindowHint(int hint, int value)
         case GLFW_WIN32_KEYBOARD_MENU:
             _glfw.hints.window.win32.keymenu = value ? GLFW_TRUE : GLFW_FALSE;
             return;
+        case GLFW_NULL_FRAME_EXPORT:
+            _glfw.hints.window.null.exportSlots = value;
+            return;
         case GLFW_COCOA_GRAPHICS_SWITCHING:
             _glfw.hints.context.nsgl.offline = value ? GLFW_TRUE : GLFW_FALSE;
             return;
@@ -387,6 +635,9 @@ GLFWAPI void glfwWindowHint(int hint, int value)
         case GLFW_MOUSE_PASSTHROUGH:
             _glfw.hints.window.mousePassthrough = value ? GLFW_TRUE : GLFW_FALSE;
             return;
+        case GLFW_SOFTWARE_FRAMEBUFFER:
+            _glfw.hints.window.softwareFramebuffer = value ? GLFW_TRUE : GLFW_FALSE;
+            return;
         case GLFW_CLIENT_API:
             _glfw.hints.context.client = value;
             return;
@@ -667,6 +918,77 @@ GLFWAPI void glfwGetFramebufferSize(GLFWwindow* handle, int* width, int* height)
     _glfw.platform.getFramebufferSize(window, width, height);
 }
 
+GLFWAPI unsigned char* glfwGetWindowPixels(GLFWwindow* handle, int* stride)
+{
+    _GLFWwindow* window = (_GLFWwindow*) handle;
+    assert(window != NULL);
+
+    if (stride)
+        *stride = 0;
+
+    _GLFW_REQUIRE_INIT_OR_RETURN(NULL);
+
+    if (!window->softwareFramebuffer)
+    {
+        _glfwInputError(GLFW_INVALID_VALUE,
+                        "Window has no software framebuffer");
+        return NULL;
+    }
+
+    return _glfw.platform.getWindowPixels(window, stride);
+}
+
+GLFWAPI void glfwPresentPixels(GLFWwindow* handle,
+                               const unsigned char* pixels,
+                               int stride,
+                               const GLFWrect* rect)
+{
+    int width, height;
+    GLFWrect area;
+    _GLFWwindow* window = (_GLFWwindow*) handle;
+    assert(window != NULL);
+    assert(pixels != NULL);
+
+    _GLFW_REQUIRE_INIT();
+
+    if (window->context.client != GLFW_NO_API)
+    {
+        _glfwInputError(GLFW_INVALID_VALUE,
+                        "Cannot present pixels to a window that has an OpenGL or OpenGL ES context");
+        return;
+    }
+
+    _glfw.platform.getFramebufferSize(window, &width, &height);
+
+    if (stride < width * 4)
+    {
+        _glfwInputError(GLFW_INVALID_VALUE,
+                        "Invalid stride %i for framebuffer width %i",
+                        stride, width);
+        return;
+    }
+
+    area.x = 0;
+    area.y = 0;
+    area.width = width;
+    area.height = height;
+
+    if (rect)
+    {
+        area.x = rect->x > 0 ? rect->x : 0;
+        area.y = rect->y > 0 ? rect->y : 0;
+        area.width = rect->x + rect->width < width ?
+                     rect->x + rect->width - area.x : width - area.x;
+        area.height = rect->y + rect->height < height ?
+                      rect->y + rect->height - area.y : height - area.y;
+    }
+
+    if (area.width <= 0 || area.height <= 0)
+        return;
+
+    _glfw.platform.presentPixels(window, pixels, stride, width, height, &area);
+}
+
 GLFWAPI void glfwGetWindowFrameSize(GLFWwindow* handle,
                                     int* left, int* top,
                                     int* right, int* bottom)
@@ -833,6 +1155,8 @@ GLFWAPI int glfwGetWindowAttrib(GLFWwindow* handle, int attrib)
             return window->focusOnShow;
         case GLFW_MOUSE_PASSTHROUGH:
             return window->mousePassthrough;
+        case GLFW_SOFTWARE_FRAMEBUFFER:
+            return window->softwareFramebuffer;
         case GLFW_TRANSPARENT_FRAMEBUFFER:
             return _glfw.platform.framebufferTransparent(window);
         case GLFW_RESIZABLE:
@@ -1088,16 +1412,27 @@ GLFWAPI void glfwPollEvents(void)
 {
     _GLFW_REQUIRE_INIT();
     _glfw.platform.pollEvents();
+    dispatchDeferredEvents();
 }
 
 GLFWAPI void glfwWaitEvents(void)
 {
+    double timeout;
+
     _GLFW_REQUIRE_INIT();
-    _glfw.platform.waitEvents();
+
+    if (_glfwGetTimerTimeout(&timeout))
+        _glfw.platform.waitEventsTimeout(timeout);
+    else
+        _glfw.platform.waitEvents();
+
+    dispatchDeferredEvents();
 }
 
 GLFWAPI void glfwWaitEventsTimeout(double timeout)
 {
+    double timerTimeout;
+
     _GLFW_REQUIRE_INIT();
     assert(timeout == timeout);
     assert(timeout >= 0.0);
@@ -1109,7 +1444,46 @@ GLFWAPI void glfwWaitEventsTimeout(double timeout)
         return;
     }
 
+    // Wake up in time for the next timer
+    if (_glfwGetTimerTimeout(&timerTimeout) && timerTimeout < timeout)
+        timeout = timerTimeout;
+
     _glfw.platform.waitEventsTimeout(timeout);
+    dispatchDeferredEvents();
+}
+
+GLFWAPI const GLFWrect* glfwGetWindowDamage(GLFWwindow* handle, int* count)
+{
+    _GLFWwindow* window = (_GLFWwindow*) handle;
+    assert(window != NULL);
+    assert(count != NULL);
+
+    *count = 0;
+
+    _GLFW_REQUIRE_INIT_OR_RETURN(NULL);
+
+    *count = window->reportedDamageCount;
+    return window->reportedDamage;
+}
+
+GLFWAPI int glfwGetEventLoopFd(void)
+{
+    int fd;
+
+    _GLFW_REQUIRE_INIT_OR_RETURN(-1);
+
+    fd = _glfw.platform.getEventLoopFd();
+    if (fd != -1)
+        _glfw.eventLoopFdUsed = GLFW_TRUE;
+
+    return fd;
+}
+
+GLFWAPI void glfwDispatchReadyEvents(void)
+{
+    _GLFW_REQUIRE_INIT();
+    _glfw.platform.pollEvents();
+    dispatchDeferredEvents();
 }
 
 GLFWAPI void glfwPostEmptyEvent(void)
@@ -1118,3 +1492,124 @@ GLFWAPI void glfwPostEmptyEvent(void)
     _glfw.platform.postEmptyEvent();
 }
 
+GLFWAPI int glfwPostUserEvent(void* payload, int tag)
+{
+    const unsigned int mask = _GLFW_USER_EVENT_COUNT - 1;
+    _GLFWuserevent* cell;
+    unsigned int head;
+
+    _GLFW_REQUIRE_INIT_OR_RETURN(GLFW_FALSE);
+
+    // Claim the cell at the head of the queue, if it has been consumed
+    head = _glfwAtomicLoad(&_glfw.userEvents.head);
+    for (;;)
+    {
+        int diff;
+
+        cell = _glfw.userEvents.cells + (head & mask);
+        diff = (int) (_glfwAtomicLoad(&cell->sequence) - head);
+
+        if (diff == 0)
+        {
+            if (_glfwAtomicCompareSwap(&_glfw.userEvents.head, head, head + 1))
+                break;
+        }
+        else if (diff < 0)
+            return GLFW_FALSE;
+
+        head = _glfwAtomicLoad(&_glfw.userEvents.head);
+    }
+
+    cell->payload = payload;
+    cell->tag = tag;
+    _glfwAtomicStore(&cell->sequence, head + 1);
+
+    _glfw.platform.postEmptyEvent();
+    return GLFW_TRUE;
+}
+
+GLFWAPI GLFWusereventfun glfwSetUserEventCallback(GLFWusereventfun cbfun)
+{
+    _GLFW_REQUIRE_INIT_OR_RETURN(NULL);
+    _GLFW_SWAP(GLFWusereventfun, _glfw.callbacks.userEvent, cbfun);
+    return cbfun;
+}
+
+GLFWAPI int glfwWatchFd(int fd, int events, GLFWfdfun callback)
+{
+    _GLFWfdwatch* watch = NULL;
+    int i;
+
+    _GLFW_REQUIRE_INIT_OR_RETURN(GLFW_FALSE);
+
+    if (fd < 0)
+    {
+        _glfwInputError(GLFW_INVALID_VALUE, "Invalid file descriptor %i", fd);
+        return GLFW_FALSE;
+    }
+
+    if (events & ~(GLFW_FD_READ | GLFW_FD_WRITE))
+    {
+        _glfwInputError(GLFW_INVALID_VALUE,
+                        "Invalid file descriptor events 0x%08X", events);
+        return GLFW_FALSE;
+    }
+
+    if (!fdWatchesSupported())
+    {
+        _glfwInputError(GLFW_FEATURE_UNAVAILABLE,
+                        "File descriptor watches are not supported on this platform");
+        return GLFW_FALSE;
+    }
+
+    for (i = 0;  i < _glfw.fdWatchCount;  i++)
+    {
+        if (_glfw.fdWatches[i].fd == fd)
+        {
+            watch = _glfw.fdWatches + i;
+            break;
+        }
+    }
+
+    if (!watch)
+    {
+        _GLFWfdwatch* watches =
+            _glfw_realloc(_glfw.fdWatches,
+                          (_glfw.fdWatchCount + 1) * sizeof(_GLFWfdwatch));
+        if (!watches)
+            return GLFW_FALSE;
+
+        _glfw.fdWatches = watches;
+        watch = _glfw.fdWatches + _glfw.fdWatchCount;
+        _glfw.fdWatchCount++;
+    }
+
+    watch->fd = fd;
+    watch->events = events;
+    watch->revents = 0;
+    watch->callback = callback;
+
+    _glfwUpdateEventLoop();
+    return GLFW_TRUE;
+}
+
+GLFWAPI void glfwUnwatchFd(int fd)
+{
+    int i;
+
+    _GLFW_REQUIRE_INIT();
+
+    for (i = 0;  i < _glfw.fdWatchCount;  i++)
+    {
+        if (_glfw.fdWatches[i].fd == fd)
+        {
+            _glfw.fdWatchCount--;
+            memmove(_glfw.fdWatches + i, _glfw.fdWatches + i + 1,
+                    (_glfw.fdWatchCount - i) * sizeof(_GLFWfdwatch));
+
+            _glfwUpdateEventLoop();
+            return;
+        }
+    }
+}
+
@@ -788,7 +788,7 @@ static void registryHandleGlobal(void* data,
 {
     if (strcmp(interface, "wl_compositor") == 0)
     {
-        _glfw.wl.compositorVersion = min(3, version);
+        _glfw.wl.compositorVersion = min(4, version);
         _glfw.wl.compositor =
             wl_registry_bind(registry, name, &wl_compositor_interface,
                              _glfw.wl.compositorVersion);
@@ -1103,10 +1103,14 @@ GLFWbool _glfwConnectWayland(int platformID, _GLFWplatform* platform)
         _glfwSetWindowFloatingWayland,
         _glfwSetWindowOpacityWayland,
         _glfwSetWindowMousePassthroughWayland,
+        _glfwGetWindowPixelsWayland,
+        _glfwSwapWindowPixelsWayland,
+        _glfwPresentPixelsWayland,
         _glfwPollEventsWayland,
         _glfwWaitEventsWayland,
         _glfwWaitEventsTimeoutWayland,
         _glfwPostEmptyEventWayland,
+        _glfwGetEventLoopFdWayland,
         _glfwGetEGLPlatformWayland,
         _glfwGetEGLNativeDisplayWayland,
         _glfwGetEGLNativeWindowWayland,
@@ -1326,6 +1330,14 @@ int _glfwInitWayland(void)
     if (_glfw.wl.seatVersion >= 4)
         _glfw.wl.timerfd = timerfd_create(CLOCK_MONOTONIC, TFD_CLOEXEC | TFD_NONBLOCK);
 
+    if (!_glfwCreateWakePOSIX(&_glfw.wl.emptyEventWake))
+    {
+        _glfwInputError(GLFW_PLATFORM_ERROR,
+                        "Wayland: Failed to create empty event wakeup: %s",
+                        strerror(errno));
+        return GLFW_FALSE;
+    }
+
     if (!_glfw.wl.wmBase)
     {
         _glfwInputError(GLFW_PLATFORM_ERROR,
@@ -1416,6 +1428,9 @@ void _glfwTerminateWayland(void)
 
     if (_glfw.wl.cursorSurface)
         wl_surface_destroy(_glfw.wl.cursorSurface);
+
+    _glfwTerminateImagePoolWayland();
+
     if (_glfw.wl.subcompositor)
         wl_subcompositor_destroy(_glfw.wl.subcompositor);
     if (_glfw.wl.compositor)
@@ -1461,6 +1476,9 @@ void _glfwTerminateWayland(void)
     if (_glfw.wl.cursorTimerfd >= 0)
         close(_glfw.wl.cursorTimerfd);
 
+    _glfwDestroyWakePOSIX(&_glfw.wl.emptyEventWake);
+    _glfwDestroyEventLoopPOSIX(&_glfw.wl.eventLoop);
+
     _glfw_free(_glfw.wl.clipboardString);
     _glfw_free(_glfw.wl.clipboardSendString);
 }
@@ -43,7 +43,6 @@ typedef VkResult (APIENTRY *PFN_vkCreateWaylandSurfaceKHR)(VkInstance,const VkWa
 typedef VkBool32 (APIENTRY *PFN_vkGetPhysicalDeviceWaylandPresentationSupportKHR)(VkPhysicalDevice,uint32_t,struct wl_display*);
 
 #include "xkb_unicode.h"
-#include "posix_poll.h"
 
 typedef int (* PFN_wl_display_flush)(struct wl_display *display);
 typedef void (* PFN_wl_display_cancel_read)(struct wl_display *display);
@@ -219,6 +218,36 @@ typedef struct _GLFWdecorationWayland
     struct wp_viewport*         viewport;
 } _GLFWdecorationWayland;
 
+// Wayland-specific shared memory pool
+//
+typedef struct _GLFWshmPoolWayland
+{
+    struct wl_shm_pool*         pool;
+    int                         fd;
+    unsigned char*              data;
+    size_t                      size;
+} _GLFWshmPoolWayland;
+
+// Wayland-specific range of the shared image pool
+//
+typedef struct _GLFWshmRangeWayland
+{
+    struct wl_buffer*           buffer;
+    size_t                      offset, size;
+} _GLFWshmRangeWayland;
+
+// Wayland-specific buffer for software presentation
+//
+typedef struct _GLFWpresentBufferWayland
+{
+    struct wl_buffer*           buffer;
+    GLFWbool                    busy;
+    int                         width, height;
+    size_t                      offset, capacity;
+    // The area that is out of date compared to the most recent pixels
+    GLFWrect                    damage;
+} _GLFWpresentBufferWayland;
+
 // Wayland-specific per-window data
 //
 typedef struct _GLFWwindowWayland
@@ -265,6 +294,14 @@ typedef struct _GLFWwindowWayland
         _GLFWdecorationWayland             top, left, right, bottom;
         int                                focus;
     } decorations;
+
+    // The pool is kept between frames and grows as needed, and its buffers
+    // are reused once the compositor has released them
+    struct {
+        _GLFWshmPoolWayland                pool;
+        size_t                             used;
+        _GLFWpresentBufferWayland          buffers[3];
+    } present;
 } _GLFWwindowWayland;
 
 // Wayland-specific global data
@@ -298,6 +335,17 @@ typedef struct _GLFWlibraryWayland
     struct wl_surface*          cursorSurface;
     const char*                 cursorPreviousName;
     int                         cursorTimerfd;
+
+    // Custom cursors and fallback decorations are sub-allocated from a single
+    // pool, with the ranges in use kept sorted by offset
+    struct {
+        _GLFWshmPoolWayland     pool;
+        _GLFWshmRangeWayland*   ranges;
+        int                     rangeCount;
+    } images;
+
+    _GLFWwakePOSIX              emptyEventWake;
+    _GLFWeventloopPOSIX         eventLoop;
     uint32_t                    serial;
     uint32_t                    pointerEnterSerial;
 
@@ -457,6 +505,9 @@ void _glfwSetWindowFloatingWayland(_GLFWwindow* window, GLFWbool enabled);
 float _glfwGetWindowOpacityWayland(_GLFWwindow* window);
 void _glfwSetWindowOpacityWayland(_GLFWwindow* window, float opacity);
 void _glfwSetWindowMousePassthroughWayland(_GLFWwindow* window, GLFWbool enabled);
+unsigned char* _glfwGetWindowPixelsWayland(_GLFWwindow* window, int* stride);
+void _glfwSwapWindowPixelsWayland(_GLFWwindow* window);
+void _glfwPresentPixelsWayland(_GLFWwindow* window, const unsigned char* pixels, int stride, int width, int height, const GLFWrect* area);
 
 void _glfwSetRawMouseMotionWayland(_GLFWwindow *window, GLFWbool enabled);
 GLFWbool _glfwRawMouseMotionSupportedWayland(void);
@@ -465,6 +516,7 @@ void _glfwPollEventsWayland(void);
 void _glfwWaitEventsWayland(void);
 void _glfwWaitEventsTimeoutWayland(double timeout);
 void _glfwPostEmptyEventWayland(void);
+int _glfwGetEventLoopFdWayland(void);
 
 void _glfwGetCursorPosWayland(_GLFWwindow* window, double* xpos, double* ypos);
 void _glfwSetCursorPosWayland(_GLFWwindow* window, double xpos, double ypos);
@@ -497,4 +549,5 @@ void _glfwSetGammaRampWayland(_GLFWmonitor* monitor, const GLFWgammaramp* ramp);
 
 void _glfwAddOutputWayland(uint32_t name, uint32_t version);
 GLFWbool _glfwInputTextWayland(_GLFWwindow* window, uint32_t scancode);
+void _glfwTerminateImagePoolWayland(void);
 
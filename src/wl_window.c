@@ -60,6 +60,18 @@ static int createTmpfileCloexec(char* tmpname)
     return fd;
 }
 
+// Grows the anonymous file to the given size, returning zero or an error number
+//
+static int allocateAnonymousFile(int fd, off_t size)
+{
+#if defined(SHM_ANON)
+    // posix_fallocate does not work on SHM descriptors
+    return ftruncate(fd, size) == 0 ? 0 : errno;
+#else
+    return posix_fallocate(fd, 0, size);
+#endif
+}
+
 /*
  * Create a new, unique, anonymous file of the given size, and
  * return the file descriptor for it. The file descriptor is set
@@ -122,12 +134,7 @@ static int createAnonymousFile(off_t size)
             return -1;
     }
 
-#if defined(SHM_ANON)
-    // posix_fallocate does not work on SHM descriptors
-    ret = ftruncate(fd, size);
-#else
-    ret = posix_fallocate(fd, 0, size);
-#endif
+    ret = allocateAnonymousFile(fd, size);
     if (ret != 0)
     {
         close(fd);
@@ -137,58 +144,325 @@ static int createAnonymousFile(off_t size)
     return fd;
 }
 
-static struct wl_buffer* createShmBuffer(const GLFWimage* image)
+static void destroyShmPool(_GLFWshmPoolWayland* pool)
 {
-    struct wl_shm_pool* pool;
-    struct wl_buffer* buffer;
-    int stride = image->width * 4;
-    int length = image->width * image->height * 4;
-    void* data;
+    if (pool->pool)
+    {
+        wl_shm_pool_destroy(pool->pool);
+        close(pool->fd);
+    }
 
-    const int fd = createAnonymousFile(length);
-    if (fd < 0)
+    if (pool->data)
+        munmap(pool->data, pool->size);
+
+    memset(pool, 0, sizeof(_GLFWshmPoolWayland));
+}
+
+// Grows the pool geometrically to at least the specified size
+//
+// NOTE: Buffers already created from the pool remain valid, but any pointers
+//       into the old mapping do not
+//
+static GLFWbool growShmPool(_GLFWshmPoolWayland* pool, size_t size)
+{
+    size_t capacity = pool->size ? pool->size : 65536;
+    while (capacity < size)
+        capacity *= 2;
+
+    if (capacity > INT32_MAX)
     {
         _glfwInputError(GLFW_PLATFORM_ERROR,
-                        "Wayland: Creating a buffer file for %d B failed: %s",
-                        length, strerror(errno));
-        return NULL;
+                        "Wayland: Buffer pool of %zu B is too large", capacity);
+        return GLFW_FALSE;
     }
 
-    data = mmap(NULL, length, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    if (!pool->pool)
+    {
+        const int fd = createAnonymousFile(capacity);
+        if (fd < 0)
+        {
+            _glfwInputError(GLFW_PLATFORM_ERROR,
+                            "Wayland: Creating a buffer file for %zu B failed: %s",
+                            capacity, strerror(errno));
+            return GLFW_FALSE;
+        }
+
+        pool->fd = fd;
+    }
+    else
+    {
+        const int error = allocateAnonymousFile(pool->fd, capacity);
+        if (error)
+        {
+            _glfwInputError(GLFW_PLATFORM_ERROR,
+                            "Wayland: Growing a buffer file to %zu B failed: %s",
+                            capacity, strerror(error));
+            return GLFW_FALSE;
+        }
+    }
+
+    void* data = mmap(NULL, capacity, PROT_READ | PROT_WRITE, MAP_SHARED,
+                      pool->fd, 0);
     if (data == MAP_FAILED)
     {
         _glfwInputError(GLFW_PLATFORM_ERROR,
                         "Wayland: mmap failed: %s", strerror(errno));
-        close(fd);
-        return NULL;
+
+        if (!pool->pool)
+            close(pool->fd);
+
+        return GLFW_FALSE;
     }
 
-    pool = wl_shm_create_pool(_glfw.wl.shm, fd, length);
+    if (pool->pool)
+    {
+        munmap(pool->data, pool->size);
+        wl_shm_pool_resize(pool->pool, (int32_t) capacity);
+    }
+    else
+        pool->pool = wl_shm_create_pool(_glfw.wl.shm, pool->fd, (int32_t) capacity);
 
-    close(fd);
-    unsigned char* source = (unsigned char*) image->pixels;
-    unsigned char* target = data;
-    for (int i = 0;  i < image->width * image->height;  i++, source += 4)
+    pool->data = data;
+    pool->size = capacity;
+    return GLFW_TRUE;
+}
+
+// Creates a buffer with a premultiplied copy of the image in the shared image
+// pool, which avoids a new file and mapping for every cursor and decoration
+//
+static struct wl_buffer* createShmBuffer(const GLFWimage* image)
+{
+    _GLFWshmRangeWayland* ranges = _glfw.wl.images.ranges;
+    const int count = _glfw.wl.images.rangeCount;
+    const int stride = image->width * 4;
+    // Keep ranges cache line aligned to not share lines between images
+    const size_t length = ((size_t) stride * image->height + 63) & ~(size_t) 63;
+    size_t offset = 0;
+    int index;
+
+    // Find the first gap between the ranges in use that fits the image
+    for (index = 0;  index < count;  index++)
     {
-        unsigned int alpha = source[3];
+        if (ranges[index].offset - offset >= length)
+            break;
+
+        offset = ranges[index].offset + ranges[index].size;
+    }
 
-        *target++ = (unsigned char) ((source[2] * alpha) / 255);
-        *target++ = (unsigned char) ((source[1] * alpha) / 255);
-        *target++ = (unsigned char) ((source[0] * alpha) / 255);
-        *target++ = (unsigned char) alpha;
+    if (offset + length > _glfw.wl.images.pool.size)
+    {
+        if (!growShmPool(&_glfw.wl.images.pool, offset + length))
+            return NULL;
     }
 
-    buffer =
-        wl_shm_pool_create_buffer(pool, 0,
+    _glfwConvertPixels(_glfw.wl.images.pool.data + offset, image->pixels,
+                       (size_t) image->width * image->height,
+                       _GLFW_PIXELS_BGRA | _GLFW_PIXELS_PREMULTIPLIED);
+
+    struct wl_buffer* buffer =
+        wl_shm_pool_create_buffer(_glfw.wl.images.pool.pool, (int32_t) offset,
                                   image->width,
                                   image->height,
                                   stride, WL_SHM_FORMAT_ARGB8888);
-    munmap(data, length);
-    wl_shm_pool_destroy(pool);
 
+    ranges = _glfw_realloc(ranges, sizeof(_GLFWshmRangeWayland) * (count + 1));
+    memmove(ranges + index + 1, ranges + index,
+            sizeof(_GLFWshmRangeWayland) * (count - index));
+    ranges[index].buffer = buffer;
+    ranges[index].offset = offset;
+    ranges[index].size = length;
+
+    _glfw.wl.images.ranges = ranges;
+    _glfw.wl.images.rangeCount++;
     return buffer;
 }
 
+// Destroys a buffer created by createShmBuffer and frees its range of the pool
+//
+static void destroyShmBuffer(struct wl_buffer* buffer)
+{
+    _GLFWshmRangeWayland* ranges = _glfw.wl.images.ranges;
+    const int count = _glfw.wl.images.rangeCount;
+
+    for (int i = 0;  i < count;  i++)
+    {
+        if (ranges[i].buffer == buffer)
+        {
+            memmove(ranges + i, ranges + i + 1,
+                    sizeof(_GLFWshmRangeWayland) * (count - i - 1));
+            _glfw.wl.images.rangeCount--;
+            break;
+        }
+    }
+
+    wl_buffer_destroy(buffer);
+}
+
+void _glfwTerminateImagePoolWayland(void)
+{
+    destroyShmPool(&_glfw.wl.images.pool);
+    _glfw_free(_glfw.wl.images.ranges);
+    _glfw.wl.images.ranges = NULL;
+    _glfw.wl.images.rangeCount = 0;
+}
+
+static void presentBufferHandleRelease(void* userData, struct wl_buffer* buffer)
+{
+    _GLFWpresentBufferWayland* slot = userData;
+    slot->busy = GLFW_FALSE;
+}
+
+static const struct wl_buffer_listener presentBufferListener =
+{
+    presentBufferHandleRelease
+};
+
+static void destroyPresentPool(_GLFWwindow* window)
+{
+    for (int i = 0;  i < 3;  i++)
+    {
+        if (window->wl.present.buffers[i].buffer)
+            wl_buffer_destroy(window->wl.present.buffers[i].buffer);
+    }
+
+    destroyShmPool(&window->wl.present.pool);
+    memset(&window->wl.present, 0, sizeof(window->wl.present));
+}
+
+// Returns a buffer of the specified size that the compositor is not reading
+//
+static _GLFWpresentBufferWayland* acquirePresentBuffer(_GLFWwindow* window,
+                                                       int width, int height)
+{
+    _GLFWpresentBufferWayland* buffers = window->wl.present.buffers;
+    _GLFWpresentBufferWayland* slot = NULL;
+
+    for (;;)
+    {
+        // Prefer a free buffer that already has the right size
+        for (int i = 0;  i < 3;  i++)
+        {
+            if (buffers[i].busy)
+                continue;
+
+            if (!slot || (buffers[i].buffer &&
+                          buffers[i].width == width &&
+                          buffers[i].height == height))
+            {
+                slot = buffers + i;
+            }
+        }
+
+        if (slot)
+            break;
+
+        // All buffers are still being read, so wait for one to be released
+        if (wl_display_roundtrip(_glfw.wl.display) == -1)
+        {
+            _glfwInputError(GLFW_PLATFORM_ERROR,
+                            "Wayland: Failed to wait for a buffer release");
+            return NULL;
+        }
+    }
+
+    if (slot->buffer && slot->width == width && slot->height == height)
+        return slot;
+
+    if (slot->buffer)
+    {
+        wl_buffer_destroy(slot->buffer);
+        slot->buffer = NULL;
+    }
+
+    const size_t size = (size_t) width * height * 4;
+
+    if (slot->capacity < size)
+    {
+        GLFWbool idle = GLFW_TRUE;
+        for (int i = 0;  i < 3;  i++)
+        {
+            if (buffers[i].busy)
+                idle = GLFW_FALSE;
+        }
+
+        if (idle)
+        {
+            // No free buffer had the right size, so nothing in the pool is
+            // worth keeping and it can be laid out from the start
+            for (int i = 0;  i < 3;  i++)
+            {
+                if (buffers[i].buffer)
+                {
+                    wl_buffer_destroy(buffers[i].buffer);
+                    buffers[i].buffer = NULL;
+                }
+
+                buffers[i].capacity = 0;
+            }
+
+            window->wl.present.used = 0;
+        }
+
+        // NOTE: Buffers still being read keep their part of the pool, so the
+        //       new buffer is placed after everything allocated so far
+        if (window->wl.present.used + size > window->wl.present.pool.size)
+        {
+            if (!growShmPool(&window->wl.present.pool,
+                             window->wl.present.used + size))
+            {
+                return NULL;
+            }
+        }
+
+        slot->offset = window->wl.present.used;
+        slot->capacity = size;
+        window->wl.present.used += size;
+    }
+
+    const uint32_t format = window->wl.transparent ?
+        WL_SHM_FORMAT_ARGB8888 : WL_SHM_FORMAT_XRGB8888;
+
+    slot->buffer = wl_shm_pool_create_buffer(window->wl.present.pool.pool,
+                                             (int32_t) slot->offset,
+                                             width, height,
+                                             width * 4, format);
+    wl_buffer_add_listener(slot->buffer, &presentBufferListener, slot);
+
+    slot->width = width;
+    slot->height = height;
+    slot->damage.x = 0;
+    slot->damage.y = 0;
+    slot->damage.width = width;
+    slot->damage.height = height;
+    return slot;
+}
+
+// Extends the damage rectangle to include the specified area
+//
+static void addPresentDamage(GLFWrect* damage, const GLFWrect* area)
+{
+    if (damage->width == 0 || damage->height == 0)
+    {
+        *damage = *area;
+        return;
+    }
+
+    int right = damage->x + damage->width;
+    int bottom = damage->y + damage->height;
+
+    if (right < area->x + area->width)
+        right = area->x + area->width;
+    if (bottom < area->y + area->height)
+        bottom = area->y + area->height;
+    if (damage->x > area->x)
+        damage->x = area->x;
+    if (damage->y > area->y)
+        damage->y = area->y;
+
+    damage->width = right - damage->x;
+    damage->height = bottom - damage->y;
+}
+
 static void createDecoration(_GLFWdecorationWayland* decoration,
                              struct wl_surface* parent,
                              struct wl_buffer* buffer, GLFWbool opaque,
@@ -494,7 +768,8 @@ static void xdgToplevelHandleConfigure(void* data,
 
         _glfwInputWindowSize(window, width, height);
         _glfwSetWindowSizeWayland(window, width, height);
-        _glfwInputWindowDamage(window);
+        _glfwInputWindowDamageRect(window, 0, 0,
+                                   window->wl.width, window->wl.height);
     }
 
     if (window->wl.wasFullscreen && window->autoIconify)
@@ -738,13 +1013,20 @@ static GLFWbool flushDisplay(void)
 static void handleEvents(double* timeout)
 {
     GLFWbool event = GLFW_FALSE;
-    struct pollfd fds[] =
+    nfds_t count = 4;
+    struct pollfd fds[5] =
     {
         { wl_display_get_fd(_glfw.wl.display), POLLIN },
         { _glfw.wl.timerfd, POLLIN },
         { _glfw.wl.cursorTimerfd, POLLIN },
+        { _glfw.wl.emptyEventWake.fds[0], POLLIN },
     };
 
+#if defined(__linux__)
+    if (_glfw.joysticksInitialized)
+        fds[count++] = (struct pollfd) { _glfw.linjs.inotify, POLLIN };
+#endif
+
     while (!event)
     {
         while (wl_display_prepare_read(_glfw.wl.display) != 0)
@@ -766,12 +1048,15 @@ static void handleEvents(double* timeout)
             return;
         }
 
-        if (!_glfwPollPOSIX(fds, 3, timeout))
+        if (!_glfwPollWithWatchesPOSIX(fds, count, timeout))
         {
             wl_display_cancel_read(_glfw.wl.display);
             return;
         }
 
+        if (_glfw.fdWatchReady)
+            event = GLFW_TRUE;
+
         if (fds[0].revents & POLLIN)
         {
             wl_display_read_events(_glfw.wl.display);
@@ -812,6 +1097,20 @@ static void handleEvents(double* timeout)
                 event = GLFW_TRUE;
             }
         }
+
+        if (fds[3].revents & POLLIN)
+        {
+            _glfwDrainWakePOSIX(&_glfw.wl.emptyEventWake);
+            event = GLFW_TRUE;
+        }
+
+#if defined(__linux__)
+        if (count > 4 && (fds[4].revents & POLLIN))
+        {
+            _glfwDetectJoystickConnectionLinux();
+            event = GLFW_TRUE;
+        }
+#endif
     }
 }
 
@@ -873,11 +1172,13 @@ void _glfwDestroyWindowWayland(_GLFWwindow* window)
         zxdg_toplevel_decoration_v1_destroy(window->wl.xdg.decoration);
 
     if (window->wl.decorations.buffer)
-        wl_buffer_destroy(window->wl.decorations.buffer);
+        destroyShmBuffer(window->wl.decorations.buffer);
 
     if (window->wl.native)
         wl_egl_window_destroy(window->wl.native);
 
+    destroyPresentPool(window);
+
     if (window->wl.xdg.toplevel)
         xdg_toplevel_destroy(window->wl.xdg.toplevel);
 
@@ -1038,7 +1339,8 @@ void _glfwShowWindowWayland(_GLFWwindow* window)
             createXdgSurface(window);
 
         window->wl.visible = GLFW_TRUE;
-        _glfwInputWindowDamage(window);
+        _glfwInputWindowDamageRect(window, 0, 0,
+                                   window->wl.width, window->wl.height);
     }
 }
 
@@ -1156,6 +1458,80 @@ void _glfwSetWindowMousePassthroughWayland(_GLFWwindow* window, GLFWbool enabled
     wl_surface_commit(window->wl.surface);
 }
 
+unsigned char* _glfwGetWindowPixelsWayland(_GLFWwindow* window, int* stride)
+{
+    _glfwInputError(GLFW_FEATURE_UNAVAILABLE,
+                    "Wayland: Software framebuffers are not supported");
+    return NULL;
+}
+
+void _glfwSwapWindowPixelsWayland(_GLFWwindow* window)
+{
+}
+
+void _glfwPresentPixelsWayland(_GLFWwindow* window,
+                               const unsigned char* pixels,
+                               int stride, int width, int height,
+                               const GLFWrect* area)
+{
+    // NOTE: The XDG surface does not exist until the window is first shown
+    //       and hidden windows must not have a buffer attached
+    if (!window->wl.visible)
+        return;
+
+    _GLFWpresentBufferWayland* slot = acquirePresentBuffer(window, width, height);
+    if (!slot)
+        return;
+
+    // The other buffers will need this area updated when they are next used
+    for (int i = 0;  i < 3;  i++)
+        addPresentDamage(&window->wl.present.buffers[i].damage, area);
+
+    const GLFWrect damage = slot->damage;
+    unsigned char* target = window->wl.present.pool.data + slot->offset +
+                            ((size_t) width * damage.y + damage.x) * 4;
+    const unsigned char* source = pixels +
+                                  (size_t) stride * damage.y + damage.x * 4;
+
+    // The alpha channel is ignored by XRGB8888 for opaque windows
+    const int format = window->wl.transparent ?
+        _GLFW_PIXELS_BGRA | _GLFW_PIXELS_PREMULTIPLIED : _GLFW_PIXELS_BGRA;
+
+    for (int y = 0;  y < damage.height;  y++)
+    {
+        _glfwConvertPixels(target + (size_t) width * 4 * y,
+                           source + (size_t) stride * y,
+                           damage.width, format);
+    }
+
+    memset(&slot->damage, 0, sizeof(slot->damage));
+
+    wl_surface_attach(window->wl.surface, slot->buffer, 0, 0);
+
+    if (_glfw.wl.compositorVersion >= WL_SURFACE_DAMAGE_BUFFER_SINCE_VERSION)
+    {
+        wl_surface_damage_buffer(window->wl.surface,
+                                 area->x, area->y,
+                                 area->width, area->height);
+    }
+    else
+    {
+        // Older compositors only take damage in surface coordinates
+        const int scale = window->wl.scale;
+        const int x = area->x / scale;
+        const int y = area->y / scale;
+
+        wl_surface_damage(window->wl.surface, x, y,
+                          (area->x + area->width + scale - 1) / scale - x,
+                          (area->y + area->height + scale - 1) / scale - y);
+    }
+
+    wl_surface_commit(window->wl.surface);
+    slot->busy = GLFW_TRUE;
+
+    wl_display_flush(_glfw.wl.display);
+}
+
 float _glfwGetWindowOpacityWayland(_GLFWwindow* window)
 {
     return 1.f;
@@ -1195,8 +1571,35 @@ void _glfwWaitEventsTimeoutWayland(double timeout)
 
 void _glfwPostEmptyEventWayland(void)
 {
-    wl_display_sync(_glfw.wl.display);
+    _glfwSignalWakePOSIX(&_glfw.wl.emptyEventWake);
+}
+
+int _glfwGetEventLoopFdWayland(void)
+{
+    int fds[5];
+    int count = 0;
+
+    fds[count++] = wl_display_get_fd(_glfw.wl.display);
+    fds[count++] = _glfw.wl.timerfd;
+    fds[count++] = _glfw.wl.cursorTimerfd;
+    fds[count++] = _glfw.wl.emptyEventWake.fds[0];
+
+#if defined(__linux__)
+    if (_glfw.joysticksInitialized)
+        fds[count++] = _glfw.linjs.inotify;
+#endif
+
     flushDisplay();
+
+    // NOTE: Events already read into the default queue, for example by
+    //       a roundtrip, do not make the display fd readable
+    GLFWbool pending = GLFW_FALSE;
+    if (wl_display_prepare_read(_glfw.wl.display) == 0)
+        wl_display_cancel_read(_glfw.wl.display);
+    else
+        pending = GLFW_TRUE;
+
+    return _glfwUpdateEventLoopPOSIX(&_glfw.wl.eventLoop, fds, count, pending);
 }
 
 void _glfwGetCursorPosWayland(_GLFWwindow* window, double* xpos, double* ypos)
@@ -1408,7 +1811,7 @@ void _glfwDestroyCursorWayland(_GLFWcursor* cursor)
         return;
 
     if (cursor->wl.buffer)
-        wl_buffer_destroy(cursor->wl.buffer);
+        destroyShmBuffer(cursor->wl.buffer);
 }
 
 static void relativePointerHandleRelativeMotion(void* data,
@@ -1421,24 +1824,22 @@ static void relativePointerHandleRelativeMotion(void* data,
                                                 wl_fixed_t dyUnaccel)
 {
     _GLFWwindow* window = data;
-    double xpos = window->virtualCursorPosX;
-    double ypos = window->virtualCursorPosY;
 
     if (window->cursorMode != GLFW_CURSOR_DISABLED)
         return;
 
     if (window->rawMouseMotion)
     {
-        xpos += wl_fixed_to_double(dxUnaccel);
-        ypos += wl_fixed_to_double(dyUnaccel);
+        _glfwInputRawMouseMotion(window,
+                                 wl_fixed_to_double(dxUnaccel),
+                                 wl_fixed_to_double(dyUnaccel));
     }
     else
     {
-        xpos += wl_fixed_to_double(dx);
-        ypos += wl_fixed_to_double(dy);
+        _glfwInputCursorPos(window,
+                            window->virtualCursorPosX + wl_fixed_to_double(dx),
+                            window->virtualCursorPosY + wl_fixed_to_double(dy));
     }
-
-    _glfwInputCursorPos(window, xpos, ypos);
 }
 
 static const struct zwp_relative_pointer_v1_listener relativePointerListener = {
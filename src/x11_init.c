@@ -35,7 +35,6 @@
 #include <stdio.h>
 #include <locale.h>
 #include <unistd.h>
-#include <fcntl.h>
 #include <errno.h>
 
 
@@ -491,26 +490,88 @@ static void inputMethodInstantiateCallback(Display* display,
     }
 }
 
-// Return the atom ID only if it is listed in the specified array
+// Atoms used regardless of window manager support
 //
-static Atom getAtomIfSupported(Atom* supportedAtoms,
-                               unsigned long atomCount,
-                               const char* atomName)
+static const struct
 {
-    const Atom atom = XInternAtom(_glfw.x11.display, atomName, False);
-
-    for (unsigned long i = 0;  i < atomCount;  i++)
-    {
-        if (supportedAtoms[i] == atom)
-            return atom;
-    }
-
-    return None;
-}
-
-// Check whether the running window manager is EWMH-compliant
+    const char* name;
+    Atom* atom;
+} requiredAtoms[] =
+{
+    // String format atoms
+    { "NULL", &_glfw.x11.NULL_ },
+    { "UTF8_STRING", &_glfw.x11.UTF8_STRING },
+    { "ATOM_PAIR", &_glfw.x11.ATOM_PAIR },
+    // Custom selection property atom
+    { "GLFW_SELECTION", &_glfw.x11.GLFW_SELECTION },
+    // ICCCM standard clipboard atoms
+    { "TARGETS", &_glfw.x11.TARGETS },
+    { "MULTIPLE", &_glfw.x11.MULTIPLE },
+    { "PRIMARY", &_glfw.x11.PRIMARY },
+    { "INCR", &_glfw.x11.INCR },
+    { "CLIPBOARD", &_glfw.x11.CLIPBOARD },
+    // Clipboard manager atoms
+    { "CLIPBOARD_MANAGER", &_glfw.x11.CLIPBOARD_MANAGER },
+    { "SAVE_TARGETS", &_glfw.x11.SAVE_TARGETS },
+    // Xdnd (drag and drop) atoms
+    { "XdndAware", &_glfw.x11.XdndAware },
+    { "XdndEnter", &_glfw.x11.XdndEnter },
+    { "XdndPosition", &_glfw.x11.XdndPosition },
+    { "XdndStatus", &_glfw.x11.XdndStatus },
+    { "XdndActionCopy", &_glfw.x11.XdndActionCopy },
+    { "XdndDrop", &_glfw.x11.XdndDrop },
+    { "XdndFinished", &_glfw.x11.XdndFinished },
+    { "XdndSelection", &_glfw.x11.XdndSelection },
+    { "XdndTypeList", &_glfw.x11.XdndTypeList },
+    { "text/uri-list", &_glfw.x11.text_uri_list },
+    // ICCCM, EWMH and Motif window property atoms
+    // These can be set safely even without WM support
+    { "WM_PROTOCOLS", &_glfw.x11.WM_PROTOCOLS },
+    { "WM_STATE", &_glfw.x11.WM_STATE },
+    { "WM_DELETE_WINDOW", &_glfw.x11.WM_DELETE_WINDOW },
+    { "_NET_SUPPORTED", &_glfw.x11.NET_SUPPORTED },
+    { "_NET_SUPPORTING_WM_CHECK", &_glfw.x11.NET_SUPPORTING_WM_CHECK },
+    { "_NET_WM_ICON", &_glfw.x11.NET_WM_ICON },
+    { "_NET_WM_PING", &_glfw.x11.NET_WM_PING },
+    { "_NET_WM_PID", &_glfw.x11.NET_WM_PID },
+    { "_NET_WM_NAME", &_glfw.x11.NET_WM_NAME },
+    { "_NET_WM_ICON_NAME", &_glfw.x11.NET_WM_ICON_NAME },
+    { "_NET_WM_BYPASS_COMPOSITOR", &_glfw.x11.NET_WM_BYPASS_COMPOSITOR },
+    { "_NET_WM_WINDOW_OPACITY", &_glfw.x11.NET_WM_WINDOW_OPACITY },
+    { "_MOTIF_WM_HINTS", &_glfw.x11.MOTIF_WM_HINTS }
+};
+
+// EWMH atoms that are only used if the window manager lists them as supported
+//
+static const struct
+{
+    const char* name;
+    Atom* atom;
+} ewmhAtoms[] =
+{
+    { "_NET_WM_STATE", &_glfw.x11.NET_WM_STATE },
+    { "_NET_WM_STATE_ABOVE", &_glfw.x11.NET_WM_STATE_ABOVE },
+    { "_NET_WM_STATE_FULLSCREEN", &_glfw.x11.NET_WM_STATE_FULLSCREEN },
+    { "_NET_WM_STATE_MAXIMIZED_VERT", &_glfw.x11.NET_WM_STATE_MAXIMIZED_VERT },
+    { "_NET_WM_STATE_MAXIMIZED_HORZ", &_glfw.x11.NET_WM_STATE_MAXIMIZED_HORZ },
+    { "_NET_WM_STATE_DEMANDS_ATTENTION", &_glfw.x11.NET_WM_STATE_DEMANDS_ATTENTION },
+    { "_NET_WM_FULLSCREEN_MONITORS", &_glfw.x11.NET_WM_FULLSCREEN_MONITORS },
+    { "_NET_WM_WINDOW_TYPE", &_glfw.x11.NET_WM_WINDOW_TYPE },
+    { "_NET_WM_WINDOW_TYPE_NORMAL", &_glfw.x11.NET_WM_WINDOW_TYPE_NORMAL },
+    { "_NET_WORKAREA", &_glfw.x11.NET_WORKAREA },
+    { "_NET_CURRENT_DESKTOP", &_glfw.x11.NET_CURRENT_DESKTOP },
+    { "_NET_ACTIVE_WINDOW", &_glfw.x11.NET_ACTIVE_WINDOW },
+    { "_NET_FRAME_EXTENTS", &_glfw.x11.NET_FRAME_EXTENTS },
+    { "_NET_REQUEST_FRAME_EXTENTS", &_glfw.x11.NET_REQUEST_FRAME_EXTENTS }
+};
+
+#define REQUIRED_ATOM_COUNT (sizeof(requiredAtoms) / sizeof(requiredAtoms[0]))
+#define EWMH_ATOM_COUNT (sizeof(ewmhAtoms) / sizeof(ewmhAtoms[0]))
+
+// Check whether the running window manager is EWMH-compliant and keep those
+// of the interned EWMH atoms that it supports
 //
-static void detectEWMH(void)
+static void detectEWMH(const Atom* candidates)
 {
     // First we read the _NET_SUPPORTING_WM_CHECK property on the root window
 
@@ -566,42 +627,25 @@ static void detectEWMH(void)
 
     // See which of the atoms we support that are supported by the WM
 
-    _glfw.x11.NET_WM_STATE =
-        getAtomIfSupported(supportedAtoms, atomCount, "_NET_WM_STATE");
-    _glfw.x11.NET_WM_STATE_ABOVE =
-        getAtomIfSupported(supportedAtoms, atomCount, "_NET_WM_STATE_ABOVE");
-    _glfw.x11.NET_WM_STATE_FULLSCREEN =
-        getAtomIfSupported(supportedAtoms, atomCount, "_NET_WM_STATE_FULLSCREEN");
-    _glfw.x11.NET_WM_STATE_MAXIMIZED_VERT =
-        getAtomIfSupported(supportedAtoms, atomCount, "_NET_WM_STATE_MAXIMIZED_VERT");
-    _glfw.x11.NET_WM_STATE_MAXIMIZED_HORZ =
-        getAtomIfSupported(supportedAtoms, atomCount, "_NET_WM_STATE_MAXIMIZED_HORZ");
-    _glfw.x11.NET_WM_STATE_DEMANDS_ATTENTION =
-        getAtomIfSupported(supportedAtoms, atomCount, "_NET_WM_STATE_DEMANDS_ATTENTION");
-    _glfw.x11.NET_WM_FULLSCREEN_MONITORS =
-        getAtomIfSupported(supportedAtoms, atomCount, "_NET_WM_FULLSCREEN_MONITORS");
-    _glfw.x11.NET_WM_WINDOW_TYPE =
-        getAtomIfSupported(supportedAtoms, atomCount, "_NET_WM_WINDOW_TYPE");
-    _glfw.x11.NET_WM_WINDOW_TYPE_NORMAL =
-        getAtomIfSupported(supportedAtoms, atomCount, "_NET_WM_WINDOW_TYPE_NORMAL");
-    _glfw.x11.NET_WORKAREA =
-        getAtomIfSupported(supportedAtoms, atomCount, "_NET_WORKAREA");
-    _glfw.x11.NET_CURRENT_DESKTOP =
-        getAtomIfSupported(supportedAtoms, atomCount, "_NET_CURRENT_DESKTOP");
-    _glfw.x11.NET_ACTIVE_WINDOW =
-        getAtomIfSupported(supportedAtoms, atomCount, "_NET_ACTIVE_WINDOW");
-    _glfw.x11.NET_FRAME_EXTENTS =
-        getAtomIfSupported(supportedAtoms, atomCount, "_NET_FRAME_EXTENTS");
-    _glfw.x11.NET_REQUEST_FRAME_EXTENTS =
-        getAtomIfSupported(supportedAtoms, atomCount, "_NET_REQUEST_FRAME_EXTENTS");
+    for (size_t i = 0;  i < EWMH_ATOM_COUNT;  i++)
+    {
+        for (unsigned long j = 0;  j < atomCount;  j++)
+        {
+            if (supportedAtoms[j] == candidates[i])
+            {
+                *ewmhAtoms[i].atom = candidates[i];
+                break;
+            }
+        }
+    }
 
     if (supportedAtoms)
         XFree(supportedAtoms);
 }
 
-// Look for and initialize supported X11 extensions
+// Loads the XF86VidMode extension library, used as a fallback for gamma ramps
 //
-static GLFWbool initExtensions(void)
+static void loadVidMode(void)
 {
 #if defined(__OpenBSD__) || defined(__NetBSD__)
     _glfw.x11.vidmode.handle = _glfwPlatformLoadModule("libXxf86vm.so");
@@ -624,7 +668,12 @@ static GLFWbool initExtensions(void)
                                       &_glfw.x11.vidmode.eventBase,
                                       &_glfw.x11.vidmode.errorBase);
     }
+}
 
+// Loads the XInput extension library, used for raw mouse motion
+//
+static void loadXInput(void)
+{
 #if defined(__CYGWIN__)
     _glfw.x11.xi.handle = _glfwPlatformLoadModule("libXi-6.so");
 #elif defined(__OpenBSD__) || defined(__NetBSD__)
@@ -656,6 +705,156 @@ static GLFWbool initExtensions(void)
             }
         }
     }
+}
+
+// Loads the Xcursor library, used for custom and theme cursors
+//
+static void loadXcursor(void)
+{
+#if defined(__CYGWIN__)
+    _glfw.x11.xcursor.handle = _glfwPlatformLoadModule("libXcursor-1.so");
+#elif defined(__OpenBSD__) || defined(__NetBSD__)
+    _glfw.x11.xcursor.handle = _glfwPlatformLoadModule("libXcursor.so");
+#else
+    _glfw.x11.xcursor.handle = _glfwPlatformLoadModule("libXcursor.so.1");
+#endif
+    if (_glfw.x11.xcursor.handle)
+    {
+        _glfw.x11.xcursor.ImageCreate = (PFN_XcursorImageCreate)
+            _glfwPlatformGetModuleSymbol(_glfw.x11.xcursor.handle, "XcursorImageCreate");
+        _glfw.x11.xcursor.ImageDestroy = (PFN_XcursorImageDestroy)
+            _glfwPlatformGetModuleSymbol(_glfw.x11.xcursor.handle, "XcursorImageDestroy");
+        _glfw.x11.xcursor.ImageLoadCursor = (PFN_XcursorImageLoadCursor)
+            _glfwPlatformGetModuleSymbol(_glfw.x11.xcursor.handle, "XcursorImageLoadCursor");
+        _glfw.x11.xcursor.GetTheme = (PFN_XcursorGetTheme)
+            _glfwPlatformGetModuleSymbol(_glfw.x11.xcursor.handle, "XcursorGetTheme");
+        _glfw.x11.xcursor.GetDefaultSize = (PFN_XcursorGetDefaultSize)
+            _glfwPlatformGetModuleSymbol(_glfw.x11.xcursor.handle, "XcursorGetDefaultSize");
+        _glfw.x11.xcursor.LibraryLoadImage = (PFN_XcursorLibraryLoadImage)
+            _glfwPlatformGetModuleSymbol(_glfw.x11.xcursor.handle, "XcursorLibraryLoadImage");
+    }
+}
+
+// Loads the XRender extension library, used to find transparent visuals
+//
+static void loadXRender(void)
+{
+#if defined(__CYGWIN__)
+    _glfw.x11.xrender.handle = _glfwPlatformLoadModule("libXrender-1.so");
+#elif defined(__OpenBSD__) || defined(__NetBSD__)
+    _glfw.x11.xrender.handle = _glfwPlatformLoadModule("libXrender.so");
+#else
+    _glfw.x11.xrender.handle = _glfwPlatformLoadModule("libXrender.so.1");
+#endif
+    if (_glfw.x11.xrender.handle)
+    {
+        _glfw.x11.xrender.QueryExtension = (PFN_XRenderQueryExtension)
+            _glfwPlatformGetModuleSymbol(_glfw.x11.xrender.handle, "XRenderQueryExtension");
+        _glfw.x11.xrender.QueryVersion = (PFN_XRenderQueryVersion)
+            _glfwPlatformGetModuleSymbol(_glfw.x11.xrender.handle, "XRenderQueryVersion");
+        _glfw.x11.xrender.FindVisualFormat = (PFN_XRenderFindVisualFormat)
+            _glfwPlatformGetModuleSymbol(_glfw.x11.xrender.handle, "XRenderFindVisualFormat");
+
+        if (XRenderQueryExtension(_glfw.x11.display,
+                                  &_glfw.x11.xrender.errorBase,
+                                  &_glfw.x11.xrender.eventBase))
+        {
+            if (XRenderQueryVersion(_glfw.x11.display,
+                                    &_glfw.x11.xrender.major,
+                                    &_glfw.x11.xrender.minor))
+            {
+                _glfw.x11.xrender.available = GLFW_TRUE;
+            }
+        }
+    }
+}
+
+// Loads the X Shape extension library, used for mouse passthrough
+//
+static void loadXShape(void)
+{
+#if defined(__CYGWIN__)
+    _glfw.x11.xshape.handle = _glfwPlatformLoadModule("libXext-6.so");
+#elif defined(__OpenBSD__) || defined(__NetBSD__)
+    _glfw.x11.xshape.handle = _glfwPlatformLoadModule("libXext.so");
+#else
+    _glfw.x11.xshape.handle = _glfwPlatformLoadModule("libXext.so.6");
+#endif
+    if (_glfw.x11.xshape.handle)
+    {
+        _glfw.x11.xshape.QueryExtension = (PFN_XShapeQueryExtension)
+            _glfwPlatformGetModuleSymbol(_glfw.x11.xshape.handle, "XShapeQueryExtension");
+        _glfw.x11.xshape.ShapeCombineRegion = (PFN_XShapeCombineRegion)
+            _glfwPlatformGetModuleSymbol(_glfw.x11.xshape.handle, "XShapeCombineRegion");
+        _glfw.x11.xshape.QueryVersion = (PFN_XShapeQueryVersion)
+            _glfwPlatformGetModuleSymbol(_glfw.x11.xshape.handle, "XShapeQueryVersion");
+        _glfw.x11.xshape.ShapeCombineMask = (PFN_XShapeCombineMask)
+            _glfwPlatformGetModuleSymbol(_glfw.x11.xshape.handle, "XShapeCombineMask");
+
+        if (XShapeQueryExtension(_glfw.x11.display,
+            &_glfw.x11.xshape.errorBase,
+            &_glfw.x11.xshape.eventBase))
+        {
+            if (XShapeQueryVersion(_glfw.x11.display,
+                &_glfw.x11.xshape.major,
+                &_glfw.x11.xshape.minor))
+            {
+                _glfw.x11.xshape.available = GLFW_TRUE;
+            }
+        }
+    }
+}
+
+// Loads the MIT-SHM extension library, used to present pixels
+//
+static void loadXShm(void)
+{
+#if defined(__CYGWIN__)
+    _glfw.x11.xshm.handle = _glfwPlatformLoadModule("libXext-6.so");
+#elif defined(__OpenBSD__) || defined(__NetBSD__)
+    _glfw.x11.xshm.handle = _glfwPlatformLoadModule("libXext.so");
+#else
+    _glfw.x11.xshm.handle = _glfwPlatformLoadModule("libXext.so.6");
+#endif
+    if (_glfw.x11.xshm.handle)
+    {
+        _glfw.x11.xshm.QueryExtension = (PFN_XShmQueryExtension)
+            _glfwPlatformGetModuleSymbol(_glfw.x11.xshm.handle, "XShmQueryExtension");
+        _glfw.x11.xshm.GetEventBase = (PFN_XShmGetEventBase)
+            _glfwPlatformGetModuleSymbol(_glfw.x11.xshm.handle, "XShmGetEventBase");
+        _glfw.x11.xshm.CreateImage = (PFN_XShmCreateImage)
+            _glfwPlatformGetModuleSymbol(_glfw.x11.xshm.handle, "XShmCreateImage");
+        _glfw.x11.xshm.Attach = (PFN_XShmAttach)
+            _glfwPlatformGetModuleSymbol(_glfw.x11.xshm.handle, "XShmAttach");
+        _glfw.x11.xshm.Detach = (PFN_XShmDetach)
+            _glfwPlatformGetModuleSymbol(_glfw.x11.xshm.handle, "XShmDetach");
+        _glfw.x11.xshm.PutImage = (PFN_XShmPutImage)
+            _glfwPlatformGetModuleSymbol(_glfw.x11.xshm.handle, "XShmPutImage");
+
+        if (_glfw.x11.xshm.QueryExtension &&
+            _glfw.x11.xshm.GetEventBase &&
+            _glfw.x11.xshm.CreateImage &&
+            _glfw.x11.xshm.Attach &&
+            _glfw.x11.xshm.Detach &&
+            _glfw.x11.xshm.PutImage)
+        {
+            if (XShmQueryExtension(_glfw.x11.display))
+            {
+                _glfw.x11.xshm.eventBase = XShmGetEventBase(_glfw.x11.display);
+                _glfw.x11.xshm.available = GLFW_TRUE;
+            }
+        }
+    }
+}
+
+// Look for and initialize supported X11 extensions
+//
+static GLFWbool initExtensions(void)
+{
+    // Extensions needed for monitor enumeration are loaded here, while the
+    // optional ones are loaded by the first function that needs them
+
+    uint64_t start = _glfwPlatformGetTimerValue();
 
 #if defined(__CYGWIN__)
     _glfw.x11.randr.handle = _glfwPlatformLoadModule("libXrandr-2.so");
@@ -751,28 +950,9 @@ static GLFWbool initExtensions(void)
                        RROutputChangeNotifyMask);
     }
 
-#if defined(__CYGWIN__)
-    _glfw.x11.xcursor.handle = _glfwPlatformLoadModule("libXcursor-1.so");
-#elif defined(__OpenBSD__) || defined(__NetBSD__)
-    _glfw.x11.xcursor.handle = _glfwPlatformLoadModule("libXcursor.so");
-#else
-    _glfw.x11.xcursor.handle = _glfwPlatformLoadModule("libXcursor.so.1");
-#endif
-    if (_glfw.x11.xcursor.handle)
-    {
-        _glfw.x11.xcursor.ImageCreate = (PFN_XcursorImageCreate)
-            _glfwPlatformGetModuleSymbol(_glfw.x11.xcursor.handle, "XcursorImageCreate");
-        _glfw.x11.xcursor.ImageDestroy = (PFN_XcursorImageDestroy)
-            _glfwPlatformGetModuleSymbol(_glfw.x11.xcursor.handle, "XcursorImageDestroy");
-        _glfw.x11.xcursor.ImageLoadCursor = (PFN_XcursorImageLoadCursor)
-            _glfwPlatformGetModuleSymbol(_glfw.x11.xcursor.handle, "XcursorImageLoadCursor");
-        _glfw.x11.xcursor.GetTheme = (PFN_XcursorGetTheme)
-            _glfwPlatformGetModuleSymbol(_glfw.x11.xcursor.handle, "XcursorGetTheme");
-        _glfw.x11.xcursor.GetDefaultSize = (PFN_XcursorGetDefaultSize)
-            _glfwPlatformGetModuleSymbol(_glfw.x11.xcursor.handle, "XcursorGetDefaultSize");
-        _glfw.x11.xcursor.LibraryLoadImage = (PFN_XcursorLibraryLoadImage)
-            _glfwPlatformGetModuleSymbol(_glfw.x11.xcursor.handle, "XcursorLibraryLoadImage");
-    }
+    _glfwRecordModuleTime("Xrandr", start);
+
+    start = _glfwPlatformGetTimerValue();
 
 #if defined(__CYGWIN__)
     _glfw.x11.xinerama.handle = _glfwPlatformLoadModule("libXinerama-1.so");
@@ -799,6 +979,8 @@ static GLFWbool initExtensions(void)
         }
     }
 
+    _glfwRecordModuleTime("Xinerama", start);
+
     _glfw.x11.xkb.major = 1;
     _glfw.x11.xkb.minor = 0;
     _glfw.x11.xkb.available =
@@ -827,161 +1009,38 @@ static GLFWbool initExtensions(void)
                               XkbGroupStateMask, XkbGroupStateMask);
     }
 
-    if (_glfw.hints.init.x11.xcbVulkanSurface)
-    {
-#if defined(__CYGWIN__)
-        _glfw.x11.x11xcb.handle = _glfwPlatformLoadModule("libX11-xcb-1.so");
-#elif defined(__OpenBSD__) || defined(__NetBSD__)
-        _glfw.x11.x11xcb.handle = _glfwPlatformLoadModule("libX11-xcb.so");
-#else
-        _glfw.x11.x11xcb.handle = _glfwPlatformLoadModule("libX11-xcb.so.1");
-#endif
-    }
-
-    if (_glfw.x11.x11xcb.handle)
-    {
-        _glfw.x11.x11xcb.GetXCBConnection = (PFN_XGetXCBConnection)
-            _glfwPlatformGetModuleSymbol(_glfw.x11.x11xcb.handle, "XGetXCBConnection");
-    }
-
-#if defined(__CYGWIN__)
-    _glfw.x11.xrender.handle = _glfwPlatformLoadModule("libXrender-1.so");
-#elif defined(__OpenBSD__) || defined(__NetBSD__)
-    _glfw.x11.xrender.handle = _glfwPlatformLoadModule("libXrender.so");
-#else
-    _glfw.x11.xrender.handle = _glfwPlatformLoadModule("libXrender.so.1");
-#endif
-    if (_glfw.x11.xrender.handle)
-    {
-        _glfw.x11.xrender.QueryExtension = (PFN_XRenderQueryExtension)
-            _glfwPlatformGetModuleSymbol(_glfw.x11.xrender.handle, "XRenderQueryExtension");
-        _glfw.x11.xrender.QueryVersion = (PFN_XRenderQueryVersion)
-            _glfwPlatformGetModuleSymbol(_glfw.x11.xrender.handle, "XRenderQueryVersion");
-        _glfw.x11.xrender.FindVisualFormat = (PFN_XRenderFindVisualFormat)
-            _glfwPlatformGetModuleSymbol(_glfw.x11.xrender.handle, "XRenderFindVisualFormat");
-
-        if (XRenderQueryExtension(_glfw.x11.display,
-                                  &_glfw.x11.xrender.errorBase,
-                                  &_glfw.x11.xrender.eventBase))
-        {
-            if (XRenderQueryVersion(_glfw.x11.display,
-                                    &_glfw.x11.xrender.major,
-                                    &_glfw.x11.xrender.minor))
-            {
-                _glfw.x11.xrender.available = GLFW_TRUE;
-            }
-        }
-    }
-
-#if defined(__CYGWIN__)
-    _glfw.x11.xshape.handle = _glfwPlatformLoadModule("libXext-6.so");
-#elif defined(__OpenBSD__) || defined(__NetBSD__)
-    _glfw.x11.xshape.handle = _glfwPlatformLoadModule("libXext.so");
-#else
-    _glfw.x11.xshape.handle = _glfwPlatformLoadModule("libXext.so.6");
-#endif
-    if (_glfw.x11.xshape.handle)
-    {
-        _glfw.x11.xshape.QueryExtension = (PFN_XShapeQueryExtension)
-            _glfwPlatformGetModuleSymbol(_glfw.x11.xshape.handle, "XShapeQueryExtension");
-        _glfw.x11.xshape.ShapeCombineRegion = (PFN_XShapeCombineRegion)
-            _glfwPlatformGetModuleSymbol(_glfw.x11.xshape.handle, "XShapeCombineRegion");
-        _glfw.x11.xshape.QueryVersion = (PFN_XShapeQueryVersion)
-            _glfwPlatformGetModuleSymbol(_glfw.x11.xshape.handle, "XShapeQueryVersion");
-        _glfw.x11.xshape.ShapeCombineMask = (PFN_XShapeCombineMask)
-            _glfwPlatformGetModuleSymbol(_glfw.x11.xshape.handle, "XShapeCombineMask");
-
-        if (XShapeQueryExtension(_glfw.x11.display,
-            &_glfw.x11.xshape.errorBase,
-            &_glfw.x11.xshape.eventBase))
-        {
-            if (XShapeQueryVersion(_glfw.x11.display,
-                &_glfw.x11.xshape.major,
-                &_glfw.x11.xshape.minor))
-            {
-                _glfw.x11.xshape.available = GLFW_TRUE;
-            }
-        }
-    }
-
     // Update the key code LUT
     // FIXME: We should listen to XkbMapNotify events to track changes to
     // the keyboard mapping.
     createKeyTables();
 
-    // String format atoms
-    _glfw.x11.NULL_ = XInternAtom(_glfw.x11.display, "NULL", False);
-    _glfw.x11.UTF8_STRING = XInternAtom(_glfw.x11.display, "UTF8_STRING", False);
-    _glfw.x11.ATOM_PAIR = XInternAtom(_glfw.x11.display, "ATOM_PAIR", False);
+    // Intern all atoms with a single request, as each separate XInternAtom
+    // would be a round trip to the server
+    {
+        char* names[REQUIRED_ATOM_COUNT + EWMH_ATOM_COUNT + 1];
+        Atom atoms[REQUIRED_ATOM_COUNT + EWMH_ATOM_COUNT + 1];
+        char cmName[32];
+        int count = 0;
 
-    // Custom selection property atom
-    _glfw.x11.GLFW_SELECTION =
-        XInternAtom(_glfw.x11.display, "GLFW_SELECTION", False);
+        for (size_t i = 0;  i < REQUIRED_ATOM_COUNT;  i++)
+            names[count++] = (char*) requiredAtoms[i].name;
+        for (size_t i = 0;  i < EWMH_ATOM_COUNT;  i++)
+            names[count++] = (char*) ewmhAtoms[i].name;
 
-    // ICCCM standard clipboard atoms
-    _glfw.x11.TARGETS = XInternAtom(_glfw.x11.display, "TARGETS", False);
-    _glfw.x11.MULTIPLE = XInternAtom(_glfw.x11.display, "MULTIPLE", False);
-    _glfw.x11.PRIMARY = XInternAtom(_glfw.x11.display, "PRIMARY", False);
-    _glfw.x11.INCR = XInternAtom(_glfw.x11.display, "INCR", False);
-    _glfw.x11.CLIPBOARD = XInternAtom(_glfw.x11.display, "CLIPBOARD", False);
+        // The compositing manager selection name contains the screen number
+        snprintf(cmName, sizeof(cmName), "_NET_WM_CM_S%u", _glfw.x11.screen);
+        names[count++] = cmName;
 
-    // Clipboard manager atoms
-    _glfw.x11.CLIPBOARD_MANAGER =
-        XInternAtom(_glfw.x11.display, "CLIPBOARD_MANAGER", False);
-    _glfw.x11.SAVE_TARGETS =
-        XInternAtom(_glfw.x11.display, "SAVE_TARGETS", False);
+        XInternAtoms(_glfw.x11.display, names, count, False, atoms);
 
-    // Xdnd (drag and drop) atoms
-    _glfw.x11.XdndAware = XInternAtom(_glfw.x11.display, "XdndAware", False);
-    _glfw.x11.XdndEnter = XInternAtom(_glfw.x11.display, "XdndEnter", False);
-    _glfw.x11.XdndPosition = XInternAtom(_glfw.x11.display, "XdndPosition", False);
-    _glfw.x11.XdndStatus = XInternAtom(_glfw.x11.display, "XdndStatus", False);
-    _glfw.x11.XdndActionCopy = XInternAtom(_glfw.x11.display, "XdndActionCopy", False);
-    _glfw.x11.XdndDrop = XInternAtom(_glfw.x11.display, "XdndDrop", False);
-    _glfw.x11.XdndFinished = XInternAtom(_glfw.x11.display, "XdndFinished", False);
-    _glfw.x11.XdndSelection = XInternAtom(_glfw.x11.display, "XdndSelection", False);
-    _glfw.x11.XdndTypeList = XInternAtom(_glfw.x11.display, "XdndTypeList", False);
-    _glfw.x11.text_uri_list = XInternAtom(_glfw.x11.display, "text/uri-list", False);
+        for (size_t i = 0;  i < REQUIRED_ATOM_COUNT;  i++)
+            *requiredAtoms[i].atom = atoms[i];
 
-    // ICCCM, EWMH and Motif window property atoms
-    // These can be set safely even without WM support
-    // The EWMH atoms that require WM support are handled in detectEWMH
-    _glfw.x11.WM_PROTOCOLS =
-        XInternAtom(_glfw.x11.display, "WM_PROTOCOLS", False);
-    _glfw.x11.WM_STATE =
-        XInternAtom(_glfw.x11.display, "WM_STATE", False);
-    _glfw.x11.WM_DELETE_WINDOW =
-        XInternAtom(_glfw.x11.display, "WM_DELETE_WINDOW", False);
-    _glfw.x11.NET_SUPPORTED =
-        XInternAtom(_glfw.x11.display, "_NET_SUPPORTED", False);
-    _glfw.x11.NET_SUPPORTING_WM_CHECK =
-        XInternAtom(_glfw.x11.display, "_NET_SUPPORTING_WM_CHECK", False);
-    _glfw.x11.NET_WM_ICON =
-        XInternAtom(_glfw.x11.display, "_NET_WM_ICON", False);
-    _glfw.x11.NET_WM_PING =
-        XInternAtom(_glfw.x11.display, "_NET_WM_PING", False);
-    _glfw.x11.NET_WM_PID =
-        XInternAtom(_glfw.x11.display, "_NET_WM_PID", False);
-    _glfw.x11.NET_WM_NAME =
-        XInternAtom(_glfw.x11.display, "_NET_WM_NAME", False);
-    _glfw.x11.NET_WM_ICON_NAME =
-        XInternAtom(_glfw.x11.display, "_NET_WM_ICON_NAME", False);
-    _glfw.x11.NET_WM_BYPASS_COMPOSITOR =
-        XInternAtom(_glfw.x11.display, "_NET_WM_BYPASS_COMPOSITOR", False);
-    _glfw.x11.NET_WM_WINDOW_OPACITY =
-        XInternAtom(_glfw.x11.display, "_NET_WM_WINDOW_OPACITY", False);
-    _glfw.x11.MOTIF_WM_HINTS =
-        XInternAtom(_glfw.x11.display, "_MOTIF_WM_HINTS", False);
-
-    // The compositing manager selection name contains the screen number
-    {
-        char name[32];
-        snprintf(name, sizeof(name), "_NET_WM_CM_S%u", _glfw.x11.screen);
-        _glfw.x11.NET_WM_CM_Sx = XInternAtom(_glfw.x11.display, name, False);
-    }
+        _glfw.x11.NET_WM_CM_Sx = atoms[count - 1];
 
-    // Detect whether an EWMH-conformant window manager is running
-    detectEWMH();
+        // Detect whether an EWMH-conformant window manager is running
+        detectEWMH(atoms + REQUIRED_ATOM_COUNT);
+    }
 
     return GLFW_TRUE;
 }
@@ -1025,9 +1084,15 @@ static void getSystemContentScale(float* xscale, float* yscale)
 //
 static Cursor createHiddenCursor(void)
 {
-    unsigned char pixels[16 * 16 * 4] = { 0 };
-    GLFWimage image = { 16, 16, pixels };
-    return _glfwCreateNativeCursorX11(&image, 0, 0);
+    // NOTE: A core cursor with an empty mask does not need Xcursor to be loaded
+    const char data[1] = { 0 };
+    XColor color = { 0 };
+    const Pixmap pixmap = XCreateBitmapFromData(_glfw.x11.display, _glfw.x11.root,
+                                                data, 1, 1);
+    const Cursor cursor = XCreatePixmapCursor(_glfw.x11.display, pixmap, pixmap,
+                                              &color, &color, 0, 0);
+    XFreePixmap(_glfw.x11.display, pixmap);
+    return cursor;
 }
 
 // Create a helper window for IPC
@@ -1044,37 +1109,6 @@ static Window createHelperWindow(void)
                          CWEventMask, &wa);
 }
 
-// Create the pipe for empty events without assumuing the OS has pipe2(2)
-//
-static GLFWbool createEmptyEventPipe(void)
-{
-    if (pipe(_glfw.x11.emptyEventPipe) != 0)
-    {
-        _glfwInputError(GLFW_PLATFORM_ERROR,
-                        "X11: Failed to create empty event pipe: %s",
-                        strerror(errno));
-        return GLFW_FALSE;
-    }
-
-    for (int i = 0; i < 2; i++)
-    {
-        const int sf = fcntl(_glfw.x11.emptyEventPipe[i], F_GETFL, 0);
-        const int df = fcntl(_glfw.x11.emptyEventPipe[i], F_GETFD, 0);
-
-        if (sf == -1 || df == -1 ||
-            fcntl(_glfw.x11.emptyEventPipe[i], F_SETFL, sf | O_NONBLOCK) == -1 ||
-            fcntl(_glfw.x11.emptyEventPipe[i], F_SETFD, df | FD_CLOEXEC) == -1)
-        {
-            _glfwInputError(GLFW_PLATFORM_ERROR,
-                            "X11: Failed to set flags for empty event pipe: %s",
-                            strerror(errno));
-            return GLFW_FALSE;
-        }
-    }
-
-    return GLFW_TRUE;
-}
-
 // X error handler
 //
 static int errorHandler(Display *display, XErrorEvent* event)
@@ -1125,7 +1159,7 @@ Cursor _glfwCreateNativeCursorX11(const GLFWimage* image, int xhot, int yhot)
 {
     Cursor cursor;
 
-    if (!_glfw.x11.xcursor.handle)
+    if (!_glfwLoadXcursorX11())
         return None;
 
     XcursorImage* native = XcursorImageCreate(image->width, image->height);
@@ -1135,18 +1169,9 @@ Cursor _glfwCreateNativeCursorX11(const GLFWimage* image, int xhot, int yhot)
     native->xhot = xhot;
     native->yhot = yhot;
 
-    unsigned char* source = (unsigned char*) image->pixels;
-    XcursorPixel* target = native->pixels;
-
-    for (int i = 0;  i < image->width * image->height;  i++, target++, source += 4)
-    {
-        unsigned int alpha = source[3];
-
-        *target = (alpha << 24) |
-                  ((unsigned char) ((source[0] * alpha) / 255) << 16) |
-                  ((unsigned char) ((source[1] * alpha) / 255) <<  8) |
-                  ((unsigned char) ((source[2] * alpha) / 255) <<  0);
-    }
+    _glfwConvertPixels(native->pixels, image->pixels,
+                       (size_t) image->width * image->height,
+                       _GLFW_PIXELS_ARGB32 | _GLFW_PIXELS_PREMULTIPLIED);
 
     cursor = XcursorImageLoadCursor(_glfw.x11.display, native);
     XcursorImageDestroy(native);
@@ -1155,6 +1180,73 @@ Cursor _glfwCreateNativeCursorX11(const GLFWimage* image, int xhot, int yhot)
 }
 
 
+// Each of these loads an optional extension library the first time it is
+// needed and returns whether it is available
+//
+GLFWbool _glfwLoadVidModeX11(void)
+{
+    _glfwLoadModuleOnce(&_glfw.x11.vidmode.loaded, "Xxf86vm", loadVidMode);
+    return _glfw.x11.vidmode.available;
+}
+
+GLFWbool _glfwLoadXInputX11(void)
+{
+    _glfwLoadModuleOnce(&_glfw.x11.xi.loaded, "Xi", loadXInput);
+    return _glfw.x11.xi.available;
+}
+
+GLFWbool _glfwLoadXcursorX11(void)
+{
+    _glfwLoadModuleOnce(&_glfw.x11.xcursor.loaded, "Xcursor", loadXcursor);
+    return _glfw.x11.xcursor.handle != NULL;
+}
+
+GLFWbool _glfwLoadXRenderX11(void)
+{
+    _glfwLoadModuleOnce(&_glfw.x11.xrender.loaded, "Xrender", loadXRender);
+    return _glfw.x11.xrender.available;
+}
+
+GLFWbool _glfwLoadXShapeX11(void)
+{
+    _glfwLoadModuleOnce(&_glfw.x11.xshape.loaded, "XShape", loadXShape);
+    return _glfw.x11.xshape.available;
+}
+
+GLFWbool _glfwLoadXShmX11(void)
+{
+    _glfwLoadModuleOnce(&_glfw.x11.xshm.loaded, "XShm", loadXShm);
+    return _glfw.x11.xshm.available;
+}
+
+// Loads the X11-XCB library, used for Vulkan XCB surfaces
+// This is called during Vulkan initialization, which holds the module lock and
+// includes this in its load time
+//
+void _glfwLoadX11XCBX11(void)
+{
+    if (_glfw.x11.x11xcb.handle)
+        return;
+
+    if (_glfw.hints.init.x11.xcbVulkanSurface)
+    {
+#if defined(__CYGWIN__)
+        _glfw.x11.x11xcb.handle = _glfwPlatformLoadModule("libX11-xcb-1.so");
+#elif defined(__OpenBSD__) || defined(__NetBSD__)
+        _glfw.x11.x11xcb.handle = _glfwPlatformLoadModule("libX11-xcb.so");
+#else
+        _glfw.x11.x11xcb.handle = _glfwPlatformLoadModule("libX11-xcb.so.1");
+#endif
+    }
+
+    if (_glfw.x11.x11xcb.handle)
+    {
+        _glfw.x11.x11xcb.GetXCBConnection = (PFN_XGetXCBConnection)
+            _glfwPlatformGetModuleSymbol(_glfw.x11.x11xcb.handle, "XGetXCBConnection");
+    }
+}
+
+
 //////////////////////////////////////////////////////////////////////////
 //////                       GLFW platform API                      //////
 //////////////////////////////////////////////////////////////////////////
@@ -1233,10 +1325,14 @@ GLFWbool _glfwConnectX11(int platformID, _GLFWplatform* platform)
         _glfwSetWindowFloatingX11,
         _glfwSetWindowOpacityX11,
         _glfwSetWindowMousePassthroughX11,
+        _glfwGetWindowPixelsX11,
+        _glfwSwapWindowPixelsX11,
+        _glfwPresentPixelsX11,
         _glfwPollEventsX11,
         _glfwWaitEventsX11,
         _glfwWaitEventsTimeoutX11,
         _glfwPostEmptyEventX11,
+        _glfwGetEventLoopFdX11,
         _glfwGetEGLPlatformX11,
         _glfwGetEGLNativeDisplayX11,
         _glfwGetEGLNativeWindowX11,
@@ -1336,20 +1432,26 @@ int _glfwInitX11(void)
         _glfwPlatformGetModuleSymbol(_glfw.x11.xlib.handle, "XCloseIM");
     _glfw.x11.xlib.ConvertSelection = (PFN_XConvertSelection)
         _glfwPlatformGetModuleSymbol(_glfw.x11.xlib.handle, "XConvertSelection");
+    _glfw.x11.xlib.CreateBitmapFromData = (PFN_XCreateBitmapFromData)
+        _glfwPlatformGetModuleSymbol(_glfw.x11.xlib.handle, "XCreateBitmapFromData");
     _glfw.x11.xlib.CreateColormap = (PFN_XCreateColormap)
         _glfwPlatformGetModuleSymbol(_glfw.x11.xlib.handle, "XCreateColormap");
     _glfw.x11.xlib.CreateFontCursor = (PFN_XCreateFontCursor)
         _glfwPlatformGetModuleSymbol(_glfw.x11.xlib.handle, "XCreateFontCursor");
+    _glfw.x11.xlib.CreateGC = (PFN_XCreateGC)
+        _glfwPlatformGetModuleSymbol(_glfw.x11.xlib.handle, "XCreateGC");
     _glfw.x11.xlib.CreateIC = (PFN_XCreateIC)
         _glfwPlatformGetModuleSymbol(_glfw.x11.xlib.handle, "XCreateIC");
+    _glfw.x11.xlib.CreateImage = (PFN_XCreateImage)
+        _glfwPlatformGetModuleSymbol(_glfw.x11.xlib.handle, "XCreateImage");
+    _glfw.x11.xlib.CreatePixmapCursor = (PFN_XCreatePixmapCursor)
+        _glfwPlatformGetModuleSymbol(_glfw.x11.xlib.handle, "XCreatePixmapCursor");
     _glfw.x11.xlib.CreateRegion = (PFN_XCreateRegion)
         _glfwPlatformGetModuleSymbol(_glfw.x11.xlib.handle, "XCreateRegion");
     _glfw.x11.xlib.CreateWindow = (PFN_XCreateWindow)
         _glfwPlatformGetModuleSymbol(_glfw.x11.xlib.handle, "XCreateWindow");
     _glfw.x11.xlib.DefineCursor = (PFN_XDefineCursor)
         _glfwPlatformGetModuleSymbol(_glfw.x11.xlib.handle, "XDefineCursor");
-    _glfw.x11.xlib.DeleteContext = (PFN_XDeleteContext)
-        _glfwPlatformGetModuleSymbol(_glfw.x11.xlib.handle, "XDeleteContext");
     _glfw.x11.xlib.DeleteProperty = (PFN_XDeleteProperty)
         _glfwPlatformGetModuleSymbol(_glfw.x11.xlib.handle, "XDeleteProperty");
     _glfw.x11.xlib.DestroyIC = (PFN_XDestroyIC)
@@ -1364,8 +1466,6 @@ int _glfwInitX11(void)
         _glfwPlatformGetModuleSymbol(_glfw.x11.xlib.handle, "XEventsQueued");
     _glfw.x11.xlib.FilterEvent = (PFN_XFilterEvent)
         _glfwPlatformGetModuleSymbol(_glfw.x11.xlib.handle, "XFilterEvent");
-    _glfw.x11.xlib.FindContext = (PFN_XFindContext)
-        _glfwPlatformGetModuleSymbol(_glfw.x11.xlib.handle, "XFindContext");
     _glfw.x11.xlib.Flush = (PFN_XFlush)
         _glfwPlatformGetModuleSymbol(_glfw.x11.xlib.handle, "XFlush");
     _glfw.x11.xlib.Free = (PFN_XFree)
@@ -1376,6 +1476,10 @@ int _glfwInitX11(void)
         _glfwPlatformGetModuleSymbol(_glfw.x11.xlib.handle, "XFreeCursor");
     _glfw.x11.xlib.FreeEventData = (PFN_XFreeEventData)
         _glfwPlatformGetModuleSymbol(_glfw.x11.xlib.handle, "XFreeEventData");
+    _glfw.x11.xlib.FreeGC = (PFN_XFreeGC)
+        _glfwPlatformGetModuleSymbol(_glfw.x11.xlib.handle, "XFreeGC");
+    _glfw.x11.xlib.FreePixmap = (PFN_XFreePixmap)
+        _glfwPlatformGetModuleSymbol(_glfw.x11.xlib.handle, "XFreePixmap");
     _glfw.x11.xlib.GetErrorText = (PFN_XGetErrorText)
         _glfwPlatformGetModuleSymbol(_glfw.x11.xlib.handle, "XGetErrorText");
     _glfw.x11.xlib.GetEventData = (PFN_XGetEventData)
@@ -1406,6 +1510,8 @@ int _glfwInitX11(void)
         _glfwPlatformGetModuleSymbol(_glfw.x11.xlib.handle, "XIconifyWindow");
     _glfw.x11.xlib.InternAtom = (PFN_XInternAtom)
         _glfwPlatformGetModuleSymbol(_glfw.x11.xlib.handle, "XInternAtom");
+    _glfw.x11.xlib.InternAtoms = (PFN_XInternAtoms)
+        _glfwPlatformGetModuleSymbol(_glfw.x11.xlib.handle, "XInternAtoms");
     _glfw.x11.xlib.LookupString = (PFN_XLookupString)
         _glfwPlatformGetModuleSymbol(_glfw.x11.xlib.handle, "XLookupString");
     _glfw.x11.xlib.MapRaised = (PFN_XMapRaised)
@@ -1424,6 +1530,8 @@ int _glfwInitX11(void)
         _glfwPlatformGetModuleSymbol(_glfw.x11.xlib.handle, "XPeekEvent");
     _glfw.x11.xlib.Pending = (PFN_XPending)
         _glfwPlatformGetModuleSymbol(_glfw.x11.xlib.handle, "XPending");
+    _glfw.x11.xlib.PutImage = (PFN_XPutImage)
+        _glfwPlatformGetModuleSymbol(_glfw.x11.xlib.handle, "XPutImage");
     _glfw.x11.xlib.QueryExtension = (PFN_XQueryExtension)
         _glfwPlatformGetModuleSymbol(_glfw.x11.xlib.handle, "XQueryExtension");
     _glfw.x11.xlib.QueryPointer = (PFN_XQueryPointer)
@@ -1436,8 +1544,6 @@ int _glfwInitX11(void)
         _glfwPlatformGetModuleSymbol(_glfw.x11.xlib.handle, "XResizeWindow");
     _glfw.x11.xlib.ResourceManagerString = (PFN_XResourceManagerString)
         _glfwPlatformGetModuleSymbol(_glfw.x11.xlib.handle, "XResourceManagerString");
-    _glfw.x11.xlib.SaveContext = (PFN_XSaveContext)
-        _glfwPlatformGetModuleSymbol(_glfw.x11.xlib.handle, "XSaveContext");
     _glfw.x11.xlib.SelectInput = (PFN_XSelectInput)
         _glfwPlatformGetModuleSymbol(_glfw.x11.xlib.handle, "XSelectInput");
     _glfw.x11.xlib.SendEvent = (PFN_XSendEvent)
@@ -1506,8 +1612,6 @@ int _glfwInitX11(void)
         _glfwPlatformGetModuleSymbol(_glfw.x11.xlib.handle, "XrmGetResource");
     _glfw.x11.xrm.GetStringDatabase = (PFN_XrmGetStringDatabase)
         _glfwPlatformGetModuleSymbol(_glfw.x11.xlib.handle, "XrmGetStringDatabase");
-    _glfw.x11.xrm.UniqueQuark = (PFN_XrmUniqueQuark)
-        _glfwPlatformGetModuleSymbol(_glfw.x11.xlib.handle, "XrmUniqueQuark");
     _glfw.x11.xlib.UnregisterIMInstantiateCallback = (PFN_XUnregisterIMInstantiateCallback)
         _glfwPlatformGetModuleSymbol(_glfw.x11.xlib.handle, "XUnregisterIMInstantiateCallback");
     _glfw.x11.xlib.utf8LookupString = (PFN_Xutf8LookupString)
@@ -1520,12 +1624,16 @@ int _glfwInitX11(void)
 
     _glfw.x11.screen = DefaultScreen(_glfw.x11.display);
     _glfw.x11.root = RootWindow(_glfw.x11.display, _glfw.x11.screen);
-    _glfw.x11.context = XUniqueContext();
 
     getSystemContentScale(&_glfw.x11.contentScaleX, &_glfw.x11.contentScaleY);
 
-    if (!createEmptyEventPipe())
+    if (!_glfwCreateWakePOSIX(&_glfw.x11.emptyEventWake))
+    {
+        _glfwInputError(GLFW_PLATFORM_ERROR,
+                        "X11: Failed to create empty event wakeup: %s",
+                        strerror(errno));
         return GLFW_FALSE;
+    }
 
     if (!initExtensions())
         return GLFW_FALSE;
@@ -1570,6 +1678,9 @@ void _glfwTerminateX11(void)
 
     _glfw_free(_glfw.x11.primarySelectionString);
     _glfw_free(_glfw.x11.clipboardString);
+    _glfw_free(_glfw.x11.icon.pixels);
+    _glfw_free(_glfw.x11.icon.data);
+    _glfw_free(_glfw.x11.windowMap.entries);
 
     XUnregisterIMInstantiateCallback(_glfw.x11.display,
                                      NULL, NULL, NULL,
@@ -1618,6 +1729,12 @@ void _glfwTerminateX11(void)
         _glfw.x11.xrender.handle = NULL;
     }
 
+    if (_glfw.x11.xshm.handle)
+    {
+        _glfwPlatformFreeModule(_glfw.x11.xshm.handle);
+        _glfw.x11.xshm.handle = NULL;
+    }
+
     if (_glfw.x11.vidmode.handle)
     {
         _glfwPlatformFreeModule(_glfw.x11.vidmode.handle);
@@ -1641,10 +1758,7 @@ void _glfwTerminateX11(void)
         _glfw.x11.xlib.handle = NULL;
     }
 
-    if (_glfw.x11.emptyEventPipe[0] || _glfw.x11.emptyEventPipe[1])
-    {
-        close(_glfw.x11.emptyEventPipe[0]);
-        close(_glfw.x11.emptyEventPipe[1]);
-    }
+    _glfwDestroyWakePOSIX(&_glfw.x11.emptyEventWake);
+    _glfwDestroyEventLoopPOSIX(&_glfw.x11.eventLoop);
 }
 
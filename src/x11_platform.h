@@ -50,6 +50,9 @@
 // The Shape extension provides custom window shapes
 #include <X11/extensions/shape.h>
 
+// The MIT-SHM extension provides image transfer through shared memory
+#include <X11/extensions/XShm.h>
+
 #define GLX_VENDOR 1
 #define GLX_RGBA_BIT 0x00000001
 #define GLX_WINDOW_BIT 0x00000001
@@ -107,13 +110,16 @@ typedef Bool (* PFN_XCheckTypedWindowEvent)(Display*,Window,int,XEvent*);
 typedef int (* PFN_XCloseDisplay)(Display*);
 typedef Status (* PFN_XCloseIM)(XIM);
 typedef int (* PFN_XConvertSelection)(Display*,Atom,Atom,Atom,Window,Time);
+typedef Pixmap (* PFN_XCreateBitmapFromData)(Display*,Drawable,const char*,unsigned int,unsigned int);
 typedef Colormap (* PFN_XCreateColormap)(Display*,Window,Visual*,int);
 typedef Cursor (* PFN_XCreateFontCursor)(Display*,unsigned int);
+typedef GC (* PFN_XCreateGC)(Display*,Drawable,unsigned long,XGCValues*);
 typedef XIC (* PFN_XCreateIC)(XIM,...);
+typedef XImage* (* PFN_XCreateImage)(Display*,Visual*,unsigned int,int,int,char*,unsigned int,unsigned int,int,int);
+typedef Cursor (* PFN_XCreatePixmapCursor)(Display*,Pixmap,Pixmap,XColor*,XColor*,unsigned int,unsigned int);
 typedef Region (* PFN_XCreateRegion)(void);
 typedef Window (* PFN_XCreateWindow)(Display*,Window,int,int,unsigned int,unsigned int,unsigned int,int,unsigned int,Visual*,unsigned long,XSetWindowAttributes*);
 typedef int (* PFN_XDefineCursor)(Display*,Window,Cursor);
-typedef int (* PFN_XDeleteContext)(Display*,XID,XContext);
 typedef int (* PFN_XDeleteProperty)(Display*,Window,Atom);
 typedef void (* PFN_XDestroyIC)(XIC);
 typedef int (* PFN_XDestroyRegion)(Region);
@@ -121,12 +127,13 @@ typedef int (* PFN_XDestroyWindow)(Display*,Window);
 typedef int (* PFN_XDisplayKeycodes)(Display*,int*,int*);
 typedef int (* PFN_XEventsQueued)(Display*,int);
 typedef Bool (* PFN_XFilterEvent)(XEvent*,Window);
-typedef int (* PFN_XFindContext)(Display*,XID,XContext,XPointer*);
 typedef int (* PFN_XFlush)(Display*);
 typedef int (* PFN_XFree)(void*);
 typedef int (* PFN_XFreeColormap)(Display*,Colormap);
 typedef int (* PFN_XFreeCursor)(Display*,Cursor);
 typedef void (* PFN_XFreeEventData)(Display*,XGenericEventCookie*);
+typedef int (* PFN_XFreeGC)(Display*,GC);
+typedef int (* PFN_XFreePixmap)(Display*,Pixmap);
 typedef int (* PFN_XGetErrorText)(Display*,int,char*,int);
 typedef Bool (* PFN_XGetEventData)(Display*,XGenericEventCookie*);
 typedef char* (* PFN_XGetICValues)(XIC,...);
@@ -143,6 +150,7 @@ typedef int (* PFN_XGrabPointer)(Display*,Window,Bool,unsigned int,int,int,Windo
 typedef Status (* PFN_XIconifyWindow)(Display*,Window,int);
 typedef Status (* PFN_XInitThreads)(void);
 typedef Atom (* PFN_XInternAtom)(Display*,const char*,Bool);
+typedef Status (* PFN_XInternAtoms)(Display*,char**,int,Bool,Atom*);
 typedef int (* PFN_XLookupString)(XKeyEvent*,char*,int,KeySym*,XComposeStatus*);
 typedef int (* PFN_XMapRaised)(Display*,Window);
 typedef int (* PFN_XMapWindow)(Display*,Window);
@@ -153,13 +161,13 @@ typedef Display* (* PFN_XOpenDisplay)(const char*);
 typedef XIM (* PFN_XOpenIM)(Display*,XrmDatabase*,char*,char*);
 typedef int (* PFN_XPeekEvent)(Display*,XEvent*);
 typedef int (* PFN_XPending)(Display*);
+typedef int (* PFN_XPutImage)(Display*,Drawable,GC,XImage*,int,int,int,int,unsigned int,unsigned int);
 typedef Bool (* PFN_XQueryExtension)(Display*,const char*,int*,int*,int*);
 typedef Bool (* PFN_XQueryPointer)(Display*,Window,Window*,Window*,int*,int*,int*,int*,unsigned int*);
 typedef int (* PFN_XRaiseWindow)(Display*,Window);
 typedef Bool (* PFN_XRegisterIMInstantiateCallback)(Display*,void*,char*,char*,XIDProc,XPointer);
 typedef int (* PFN_XResizeWindow)(Display*,Window,unsigned int,unsigned int);
 typedef char* (* PFN_XResourceManagerString)(Display*);
-typedef int (* PFN_XSaveContext)(Display*,XID,XContext,const char*);
 typedef int (* PFN_XSelectInput)(Display*,Window,long);
 typedef Status (* PFN_XSendEvent)(Display*,Window,Bool,long,XEvent*);
 typedef int (* PFN_XSetClassHint)(Display*,Window,XClassHint*);
@@ -195,7 +203,6 @@ typedef void (* PFN_XrmDestroyDatabase)(XrmDatabase);
 typedef Bool (* PFN_XrmGetResource)(XrmDatabase,const char*,const char*,char**,XrmValue*);
 typedef XrmDatabase (* PFN_XrmGetStringDatabase)(const char*);
 typedef void (* PFN_XrmInitialize)(void);
-typedef XrmQuark (* PFN_XrmUniqueQuark)(void);
 typedef Bool (* PFN_XUnregisterIMInstantiateCallback)(Display*,void*,char*,char*,XIDProc,XPointer);
 typedef int (* PFN_Xutf8LookupString)(XIC,XKeyPressedEvent*,char*,int,KeySym*,Status*);
 typedef void (* PFN_Xutf8SetWMProperties)(Display*,Window,const char*,const char*,char**,int,XSizeHints*,XWMHints*,XClassHint*);
@@ -209,13 +216,16 @@ typedef void (* PFN_Xutf8SetWMProperties)(Display*,Window,const char*,const char
 #define XCloseDisplay _glfw.x11.xlib.CloseDisplay
 #define XCloseIM _glfw.x11.xlib.CloseIM
 #define XConvertSelection _glfw.x11.xlib.ConvertSelection
+#define XCreateBitmapFromData _glfw.x11.xlib.CreateBitmapFromData
 #define XCreateColormap _glfw.x11.xlib.CreateColormap
 #define XCreateFontCursor _glfw.x11.xlib.CreateFontCursor
+#define XCreateGC _glfw.x11.xlib.CreateGC
 #define XCreateIC _glfw.x11.xlib.CreateIC
+#define XCreateImage _glfw.x11.xlib.CreateImage
+#define XCreatePixmapCursor _glfw.x11.xlib.CreatePixmapCursor
 #define XCreateRegion _glfw.x11.xlib.CreateRegion
 #define XCreateWindow _glfw.x11.xlib.CreateWindow
 #define XDefineCursor _glfw.x11.xlib.DefineCursor
-#define XDeleteContext _glfw.x11.xlib.DeleteContext
 #define XDeleteProperty _glfw.x11.xlib.DeleteProperty
 #define XDestroyIC _glfw.x11.xlib.DestroyIC
 #define XDestroyRegion _glfw.x11.xlib.DestroyRegion
@@ -223,12 +233,13 @@ typedef void (* PFN_Xutf8SetWMProperties)(Display*,Window,const char*,const char
 #define XDisplayKeycodes _glfw.x11.xlib.DisplayKeycodes
 #define XEventsQueued _glfw.x11.xlib.EventsQueued
 #define XFilterEvent _glfw.x11.xlib.FilterEvent
-#define XFindContext _glfw.x11.xlib.FindContext
 #define XFlush _glfw.x11.xlib.Flush
 #define XFree _glfw.x11.xlib.Free
 #define XFreeColormap _glfw.x11.xlib.FreeColormap
 #define XFreeCursor _glfw.x11.xlib.FreeCursor
 #define XFreeEventData _glfw.x11.xlib.FreeEventData
+#define XFreeGC _glfw.x11.xlib.FreeGC
+#define XFreePixmap _glfw.x11.xlib.FreePixmap
 #define XGetErrorText _glfw.x11.xlib.GetErrorText
 #define XGetEventData _glfw.x11.xlib.GetEventData
 #define XGetICValues _glfw.x11.xlib.GetICValues
@@ -244,6 +255,7 @@ typedef void (* PFN_Xutf8SetWMProperties)(Display*,Window,const char*,const char
 #define XGrabPointer _glfw.x11.xlib.GrabPointer
 #define XIconifyWindow _glfw.x11.xlib.IconifyWindow
 #define XInternAtom _glfw.x11.xlib.InternAtom
+#define XInternAtoms _glfw.x11.xlib.InternAtoms
 #define XLookupString _glfw.x11.xlib.LookupString
 #define XMapRaised _glfw.x11.xlib.MapRaised
 #define XMapWindow _glfw.x11.xlib.MapWindow
@@ -253,13 +265,13 @@ typedef void (* PFN_Xutf8SetWMProperties)(Display*,Window,const char*,const char
 #define XOpenIM _glfw.x11.xlib.OpenIM
 #define XPeekEvent _glfw.x11.xlib.PeekEvent
 #define XPending _glfw.x11.xlib.Pending
+#define XPutImage _glfw.x11.xlib.PutImage
 #define XQueryExtension _glfw.x11.xlib.QueryExtension
 #define XQueryPointer _glfw.x11.xlib.QueryPointer
 #define XRaiseWindow _glfw.x11.xlib.RaiseWindow
 #define XRegisterIMInstantiateCallback _glfw.x11.xlib.RegisterIMInstantiateCallback
 #define XResizeWindow _glfw.x11.xlib.ResizeWindow
 #define XResourceManagerString _glfw.x11.xlib.ResourceManagerString
-#define XSaveContext _glfw.x11.xlib.SaveContext
 #define XSelectInput _glfw.x11.xlib.SelectInput
 #define XSendEvent _glfw.x11.xlib.SendEvent
 #define XSetClassHint _glfw.x11.xlib.SetClassHint
@@ -294,7 +306,6 @@ typedef void (* PFN_Xutf8SetWMProperties)(Display*,Window,const char*,const char
 #define XrmDestroyDatabase _glfw.x11.xrm.DestroyDatabase
 #define XrmGetResource _glfw.x11.xrm.GetResource
 #define XrmGetStringDatabase _glfw.x11.xrm.GetStringDatabase
-#define XrmUniqueQuark _glfw.x11.xrm.UniqueQuark
 #define XUnregisterIMInstantiateCallback _glfw.x11.xlib.UnregisterIMInstantiateCallback
 #define Xutf8LookupString _glfw.x11.xlib.utf8LookupString
 #define Xutf8SetWMProperties _glfw.x11.xlib.utf8SetWMProperties
@@ -391,6 +402,20 @@ typedef void (* PFN_XShapeCombineMask)(Display*,Window,int,int,int,Pixmap,int);
 #define XShapeCombineRegion _glfw.x11.xshape.ShapeCombineRegion
 #define XShapeCombineMask _glfw.x11.xshape.ShapeCombineMask
 
+typedef Bool (* PFN_XShmQueryExtension)(Display*);
+typedef int (* PFN_XShmGetEventBase)(Display*);
+typedef XImage* (* PFN_XShmCreateImage)(Display*,Visual*,unsigned int,int,char*,XShmSegmentInfo*,unsigned int,unsigned int);
+typedef Bool (* PFN_XShmAttach)(Display*,XShmSegmentInfo*);
+typedef Bool (* PFN_XShmDetach)(Display*,XShmSegmentInfo*);
+typedef Bool (* PFN_XShmPutImage)(Display*,Drawable,GC,XImage*,int,int,int,int,unsigned int,unsigned int,Bool);
+
+#define XShmQueryExtension _glfw.x11.xshm.QueryExtension
+#define XShmGetEventBase _glfw.x11.xshm.GetEventBase
+#define XShmCreateImage _glfw.x11.xshm.CreateImage
+#define XShmAttach _glfw.x11.xshm.Attach
+#define XShmDetach _glfw.x11.xshm.Detach
+#define XShmPutImage _glfw.x11.xshm.PutImage
+
 typedef int (*PFNGLXGETFBCONFIGATTRIBPROC)(Display*,GLXFBConfig,int,int*);
 typedef const char* (*PFNGLXGETCLIENTSTRINGPROC)(Display*,int);
 typedef Bool (*PFNGLXQUERYEXTENSIONPROC)(Display*,int*,int*);
@@ -453,7 +478,6 @@ typedef VkResult (APIENTRY *PFN_vkCreateXcbSurfaceKHR)(VkInstance,const VkXcbSur
 typedef VkBool32 (APIENTRY *PFN_vkGetPhysicalDeviceXcbPresentationSupportKHR)(VkPhysicalDevice,uint32_t,xcb_connection_t*,xcb_visualid_t);
 
 #include "xkb_unicode.h"
-#include "posix_poll.h"
 
 #define GLFW_X11_WINDOW_STATE           _GLFWwindowX11 x11;
 #define GLFW_X11_LIBRARY_WINDOW_STATE   _GLFWlibraryX11 x11;
@@ -519,6 +543,14 @@ typedef struct _GLFWlibraryGLX
     GLFWbool        ARB_context_flush_control;
 } _GLFWlibraryGLX;
 
+// X11-specific window map entry
+//
+typedef struct _GLFWwindowmapX11
+{
+    Window          handle;
+    _GLFWwindow*    window;
+} _GLFWwindowmapX11;
+
 // X11-specific per-window data
 //
 typedef struct _GLFWwindowX11
@@ -528,6 +560,11 @@ typedef struct _GLFWwindowX11
     Window          parent;
     XIC             ic;
 
+    // The currently selected event mask and the extra events required by the
+    // input context
+    long            eventMask;
+    long            filterMask;
+
     GLFWbool        overrideRedirect;
     GLFWbool        iconified;
     GLFWbool        maximized;
@@ -535,18 +572,46 @@ typedef struct _GLFWwindowX11
     // Whether the visual supports framebuffer transparency
     GLFWbool        transparent;
 
-    // Cached position and size used to filter out duplicate events
+    // Position and size as last reported by the server, used to answer
+    // queries and to filter out duplicate events
     int             width, height;
     int             xpos, ypos;
+    // Whether the size or position changed since the last reported event
+    GLFWbool        sizeChanged, posChanged;
+
+    // Position of the window within its parent and root position of the parent,
+    // used to translate parent relative ConfigureNotify positions
+    int             parentOffsetX, parentOffsetY;
+    int             parentRootX, parentRootY;
+    GLFWbool        parentRootKnown;
 
     // The last received cursor position, regardless of source
     int             lastCursorPosX, lastCursorPosY;
+    // Whether the cursor is known to be inside the window, which means the last
+    // received cursor position is current while motion events are selected
+    GLFWbool        cursorInside;
     // The last position the cursor was warped to by GLFW
     int             warpCursorPosX, warpCursorPosY;
 
     // The time of the last KeyPress event per keycode, for discarding
     // duplicate key events generated for some keys by ibus
     Time            keyPressTimes[256];
+
+    // Images for glfwPresentPixels, either two shared memory images used in
+    // turn or a single band of rows uploaded with XPutImage
+    GC              presentGC;
+    XImage*         presentImages[2];
+    XShmSegmentInfo presentSegments[2];
+    // The number of shared memory puts not yet completed per image
+    int             presentPending[2];
+    int             presentIndex;
+    GLFWbool        presentShared;
+    int             presentWidth, presentHeight;
+    // Bit offsets of the RGBA channels in the image pixel format
+    int             presentShifts[4];
+
+    // The serial of the cached icon last set on this window, or zero
+    unsigned int    iconSerial;
 } _GLFWwindowX11;
 
 // X11-specific global data
@@ -563,8 +628,15 @@ typedef struct _GLFWlibraryX11
     Window          helperWindowHandle;
     // Invisible cursor for hidden cursor mode
     Cursor          hiddenCursorHandle;
-    // Context for mapping window XIDs to _GLFWwindow pointers
-    XContext        context;
+    // Open addressing hash map from window XIDs to _GLFWwindow pointers
+    struct {
+        _GLFWwindowmapX11* entries;
+        int             size;
+        int             count;
+        // The most recently looked up entry
+        Window          lastHandle;
+        _GLFWwindow*    lastWindow;
+    } windowMap;
     // XIM input method
     XIM             im;
     // Most recent error code received by X error handler
@@ -573,6 +645,15 @@ typedef struct _GLFWlibraryX11
     char*           primarySelectionString;
     // Clipboard string (while the selection is owned)
     char*           clipboardString;
+    // The most recently set window icon, as property data and as a copy of
+    // the source pixels, so other windows can set it without converting it
+    struct {
+        uint64_t        hash;
+        unsigned char*  pixels;
+        unsigned long*  data;
+        int             longCount;
+        unsigned int    serial;
+    } icon;
     // Key name string
     char            keynames[GLFW_KEY_LAST + 1][5];
     // X11 keycode to GLFW key LUT
@@ -583,7 +664,10 @@ typedef struct _GLFWlibraryX11
     double          restoreCursorPosX, restoreCursorPosY;
     // The window whose disabled cursor mode is active
     _GLFWwindow*    disabledCursorWindow;
-    int             emptyEventPipe[2];
+    // Whether any window has unreported size or position changes
+    GLFWbool        configurePending;
+    _GLFWwakePOSIX  emptyEventWake;
+    _GLFWeventloopPOSIX eventLoop;
 
     // Window manager atoms
     Atom            NET_SUPPORTED;
@@ -654,13 +738,16 @@ typedef struct _GLFWlibraryX11
         PFN_XCloseDisplay CloseDisplay;
         PFN_XCloseIM CloseIM;
         PFN_XConvertSelection ConvertSelection;
+        PFN_XCreateBitmapFromData CreateBitmapFromData;
         PFN_XCreateColormap CreateColormap;
         PFN_XCreateFontCursor CreateFontCursor;
+        PFN_XCreateGC CreateGC;
         PFN_XCreateIC CreateIC;
+        PFN_XCreateImage CreateImage;
+        PFN_XCreatePixmapCursor CreatePixmapCursor;
         PFN_XCreateRegion CreateRegion;
         PFN_XCreateWindow CreateWindow;
         PFN_XDefineCursor DefineCursor;
-        PFN_XDeleteContext DeleteContext;
         PFN_XDeleteProperty DeleteProperty;
         PFN_XDestroyIC DestroyIC;
         PFN_XDestroyRegion DestroyRegion;
@@ -668,12 +755,13 @@ typedef struct _GLFWlibraryX11
         PFN_XDisplayKeycodes DisplayKeycodes;
         PFN_XEventsQueued EventsQueued;
         PFN_XFilterEvent FilterEvent;
-        PFN_XFindContext FindContext;
         PFN_XFlush Flush;
         PFN_XFree Free;
         PFN_XFreeColormap FreeColormap;
         PFN_XFreeCursor FreeCursor;
         PFN_XFreeEventData FreeEventData;
+        PFN_XFreeGC FreeGC;
+        PFN_XFreePixmap FreePixmap;
         PFN_XGetErrorText GetErrorText;
         PFN_XGetEventData GetEventData;
         PFN_XGetICValues GetICValues;
@@ -689,6 +777,7 @@ typedef struct _GLFWlibraryX11
         PFN_XGrabPointer GrabPointer;
         PFN_XIconifyWindow IconifyWindow;
         PFN_XInternAtom InternAtom;
+        PFN_XInternAtoms InternAtoms;
         PFN_XLookupString LookupString;
         PFN_XMapRaised MapRaised;
         PFN_XMapWindow MapWindow;
@@ -698,13 +787,13 @@ typedef struct _GLFWlibraryX11
         PFN_XOpenIM OpenIM;
         PFN_XPeekEvent PeekEvent;
         PFN_XPending Pending;
+        PFN_XPutImage PutImage;
         PFN_XQueryExtension QueryExtension;
         PFN_XQueryPointer QueryPointer;
         PFN_XRaiseWindow RaiseWindow;
         PFN_XRegisterIMInstantiateCallback RegisterIMInstantiateCallback;
         PFN_XResizeWindow ResizeWindow;
         PFN_XResourceManagerString ResourceManagerString;
-        PFN_XSaveContext SaveContext;
         PFN_XSelectInput SelectInput;
         PFN_XSendEvent SendEvent;
         PFN_XSetClassHint SetClassHint;
@@ -736,7 +825,6 @@ typedef struct _GLFWlibraryX11
         PFN_XrmDestroyDatabase DestroyDatabase;
         PFN_XrmGetResource GetResource;
         PFN_XrmGetStringDatabase GetStringDatabase;
-        PFN_XrmUniqueQuark UniqueQuark;
     } xrm;
 
     struct {
@@ -802,6 +890,7 @@ typedef struct _GLFWlibraryX11
     } xdnd;
 
     struct {
+        GLFWbool    loaded;
         void*       handle;
         PFN_XcursorImageCreate ImageCreate;
         PFN_XcursorImageDestroy ImageDestroy;
@@ -827,6 +916,7 @@ typedef struct _GLFWlibraryX11
     } x11xcb;
 
     struct {
+        GLFWbool    loaded;
         GLFWbool    available;
         void*       handle;
         int         eventBase;
@@ -838,6 +928,7 @@ typedef struct _GLFWlibraryX11
     } vidmode;
 
     struct {
+        GLFWbool    loaded;
         GLFWbool    available;
         void*       handle;
         int         majorOpcode;
@@ -850,6 +941,7 @@ typedef struct _GLFWlibraryX11
     } xi;
 
     struct {
+        GLFWbool    loaded;
         GLFWbool    available;
         void*       handle;
         int         major;
@@ -862,6 +954,7 @@ typedef struct _GLFWlibraryX11
     } xrender;
 
     struct {
+        GLFWbool    loaded;
         GLFWbool    available;
         void*       handle;
         int         major;
@@ -873,6 +966,19 @@ typedef struct _GLFWlibraryX11
         PFN_XShapeQueryVersion QueryVersion;
         PFN_XShapeCombineMask ShapeCombineMask;
     } xshape;
+
+    struct {
+        GLFWbool    loaded;
+        GLFWbool    available;
+        void*       handle;
+        int         eventBase;
+        PFN_XShmQueryExtension QueryExtension;
+        PFN_XShmGetEventBase GetEventBase;
+        PFN_XShmCreateImage CreateImage;
+        PFN_XShmAttach Attach;
+        PFN_XShmDetach Detach;
+        PFN_XShmPutImage PutImage;
+    } xshm;
 } _GLFWlibraryX11;
 
 // X11-specific per-monitor data
@@ -933,6 +1039,9 @@ void _glfwSetWindowFloatingX11(_GLFWwindow* window, GLFWbool enabled);
 float _glfwGetWindowOpacityX11(_GLFWwindow* window);
 void _glfwSetWindowOpacityX11(_GLFWwindow* window, float opacity);
 void _glfwSetWindowMousePassthroughX11(_GLFWwindow* window, GLFWbool enabled);
+unsigned char* _glfwGetWindowPixelsX11(_GLFWwindow* window, int* stride);
+void _glfwSwapWindowPixelsX11(_GLFWwindow* window);
+void _glfwPresentPixelsX11(_GLFWwindow* window, const unsigned char* pixels, int stride, int width, int height, const GLFWrect* area);
 
 void _glfwSetRawMouseMotionX11(_GLFWwindow *window, GLFWbool enabled);
 GLFWbool _glfwRawMouseMotionSupportedX11(void);
@@ -941,6 +1050,7 @@ void _glfwPollEventsX11(void);
 void _glfwWaitEventsX11(void);
 void _glfwWaitEventsTimeoutX11(double timeout);
 void _glfwPostEmptyEventX11(void);
+int _glfwGetEventLoopFdX11(void);
 
 void _glfwGetCursorPosX11(_GLFWwindow* window, double* xpos, double* ypos);
 void _glfwSetCursorPosX11(_GLFWwindow* window, double xpos, double ypos);
@@ -977,6 +1087,14 @@ void _glfwRestoreVideoModeX11(_GLFWmonitor* monitor);
 
 Cursor _glfwCreateNativeCursorX11(const GLFWimage* image, int xhot, int yhot);
 
+GLFWbool _glfwLoadVidModeX11(void);
+GLFWbool _glfwLoadXInputX11(void);
+GLFWbool _glfwLoadXcursorX11(void);
+GLFWbool _glfwLoadXRenderX11(void);
+GLFWbool _glfwLoadXShapeX11(void);
+GLFWbool _glfwLoadXShmX11(void);
+void _glfwLoadX11XCBX11(void);
+
 unsigned long _glfwGetWindowPropertyX11(Window window,
                                         Atom property,
                                         Atom type,
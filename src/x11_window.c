@@ -33,6 +33,8 @@
 #include <X11/Xmd.h>
 
 #include <poll.h>
+#include <sys/ipc.h>
+#include <sys/shm.h>
 
 #include <string.h>
 #include <stdio.h>
@@ -83,7 +85,7 @@ static GLFWbool waitForAnyEvent(double* timeout)
     struct pollfd fds[3] =
     {
         { ConnectionNumber(_glfw.x11.display), POLLIN },
-        { _glfw.x11.emptyEventPipe[0], POLLIN }
+        { _glfw.x11.emptyEventWake.fds[0], POLLIN }
     };
 
 #if defined(__linux__)
@@ -93,7 +95,7 @@ static GLFWbool waitForAnyEvent(double* timeout)
 
     while (!XPending(_glfw.x11.display))
     {
-        if (!_glfwPollPOSIX(fds, count, timeout))
+        if (!_glfwPollWithWatchesPOSIX(fds, count, timeout))
             return GLFW_FALSE;
 
         for (int i = 1; i < count; i++)
@@ -101,35 +103,12 @@ static GLFWbool waitForAnyEvent(double* timeout)
             if (fds[i].revents & POLLIN)
                 return GLFW_TRUE;
         }
-    }
-
-    return GLFW_TRUE;
-}
 
-// Writes a byte to the empty event pipe
-//
-static void writeEmptyEvent(void)
-{
-    for (;;)
-    {
-        const char byte = 0;
-        const int result = write(_glfw.x11.emptyEventPipe[1], &byte, 1);
-        if (result == 1 || (result == -1 && errno != EINTR))
-            break;
+        if (_glfw.fdWatchReady)
+            return GLFW_TRUE;
     }
-}
 
-// Drains available data from the empty event pipe
-//
-static void drainEmptyEvents(void)
-{
-    for (;;)
-    {
-        char dummy[64];
-        const int result = read(_glfw.x11.emptyEventPipe[0], dummy, sizeof(dummy));
-        if (result == -1 && errno != EINTR)
-            break;
-    }
+    return GLFW_TRUE;
 }
 
 // Waits until a VisibilityNotify event arrives for the specified window or the
@@ -152,6 +131,42 @@ static GLFWbool waitForVisibilityNotify(_GLFWwindow* window)
     return GLFW_TRUE;
 }
 
+// Returns whether the window is maximized according to its EWMH state
+//
+static GLFWbool getWindowMaximized(_GLFWwindow* window)
+{
+    Atom* states;
+    GLFWbool maximized = GLFW_FALSE;
+
+    if (!_glfw.x11.NET_WM_STATE ||
+        !_glfw.x11.NET_WM_STATE_MAXIMIZED_VERT ||
+        !_glfw.x11.NET_WM_STATE_MAXIMIZED_HORZ)
+    {
+        return maximized;
+    }
+
+    const unsigned long count =
+        _glfwGetWindowPropertyX11(window->x11.handle,
+                                  _glfw.x11.NET_WM_STATE,
+                                  XA_ATOM,
+                                  (unsigned char**) &states);
+
+    for (unsigned long i = 0;  i < count;  i++)
+    {
+        if (states[i] == _glfw.x11.NET_WM_STATE_MAXIMIZED_VERT ||
+            states[i] == _glfw.x11.NET_WM_STATE_MAXIMIZED_HORZ)
+        {
+            maximized = GLFW_TRUE;
+            break;
+        }
+    }
+
+    if (states)
+        XFree(states);
+
+    return maximized;
+}
+
 // Returns whether the window is iconified
 //
 static int getWindowState(_GLFWwindow* window)
@@ -458,29 +473,6 @@ static char** parseUriList(char* text, int* count)
     return paths;
 }
 
-// Decode a Unicode code point from a UTF-8 stream
-// Based on cutef8 by Jeff Bezanson (Public Domain)
-//
-static uint32_t decodeUTF8(const char** s)
-{
-    uint32_t codepoint = 0, count = 0;
-    static const uint32_t offsets[] =
-    {
-        0x00000000u, 0x00003080u, 0x000e2080u,
-        0x03c82080u, 0xfa082080u, 0x82082080u
-    };
-
-    do
-    {
-        codepoint = (codepoint << 6) + (unsigned char) **s;
-        (*s)++;
-        count++;
-    } while ((**s & 0xc0) == 0x80);
-
-    assert(count <= 6);
-    return codepoint - offsets[count - 1];
-}
-
 // Convert the specified Latin-1 string to UTF-8
 //
 static char* convertLatin1toUTF8(const char* source)
@@ -500,6 +492,300 @@ static char* convertLatin1toUTF8(const char* source)
     return target;
 }
 
+// Returns the window map slot where probing for the specified XID starts
+//
+static int getWindowMapSlot(Window handle)
+{
+    // Fibonacci hashing spreads the mostly sequential XIDs across the map
+    const uint64_t hash = (uint64_t) handle * 0x9e3779b97f4a7c15ull;
+    return (int) (hash >> 32) & (_glfw.x11.windowMap.size - 1);
+}
+
+// Adds the specified window to the window map, growing the map if needed
+//
+static GLFWbool addWindowMapEntry(_GLFWwindow* window)
+{
+    if ((_glfw.x11.windowMap.count + 1) * 2 > _glfw.x11.windowMap.size)
+    {
+        const int oldSize = _glfw.x11.windowMap.size;
+        _GLFWwindowmapX11* oldEntries = _glfw.x11.windowMap.entries;
+        const int size = oldSize ? oldSize * 2 : 16;
+
+        _GLFWwindowmapX11* entries = _glfw_calloc(size, sizeof(_GLFWwindowmapX11));
+        if (!entries)
+            return GLFW_FALSE;
+
+        _glfw.x11.windowMap.entries = entries;
+        _glfw.x11.windowMap.size = size;
+
+        for (int i = 0;  i < oldSize;  i++)
+        {
+            if (!oldEntries[i].handle)
+                continue;
+
+            int slot = getWindowMapSlot(oldEntries[i].handle);
+            while (entries[slot].handle)
+                slot = (slot + 1) & (size - 1);
+
+            entries[slot] = oldEntries[i];
+        }
+
+        _glfw_free(oldEntries);
+    }
+
+    int slot = getWindowMapSlot(window->x11.handle);
+    while (_glfw.x11.windowMap.entries[slot].handle)
+        slot = (slot + 1) & (_glfw.x11.windowMap.size - 1);
+
+    _glfw.x11.windowMap.entries[slot].handle = window->x11.handle;
+    _glfw.x11.windowMap.entries[slot].window = window;
+    _glfw.x11.windowMap.count++;
+    return GLFW_TRUE;
+}
+
+// Removes the specified XID from the window map
+//
+static void removeWindowMapEntry(Window handle)
+{
+    _GLFWwindowmapX11* entries = _glfw.x11.windowMap.entries;
+    const int mask = _glfw.x11.windowMap.size - 1;
+
+    if (_glfw.x11.windowMap.lastHandle == handle)
+    {
+        _glfw.x11.windowMap.lastHandle = None;
+        _glfw.x11.windowMap.lastWindow = NULL;
+    }
+
+    if (!entries)
+        return;
+
+    int slot = getWindowMapSlot(handle);
+    while (entries[slot].handle != handle)
+    {
+        if (!entries[slot].handle)
+            return;
+
+        slot = (slot + 1) & mask;
+    }
+
+    entries[slot].handle = None;
+    entries[slot].window = NULL;
+    _glfw.x11.windowMap.count--;
+
+    // Shift back any following entries that would no longer be reachable from
+    // their home slot, so that lookups can stop at the first empty slot
+    for (int next = (slot + 1) & mask;  entries[next].handle;  next = (next + 1) & mask)
+    {
+        const int home = getWindowMapSlot(entries[next].handle);
+        GLFWbool reachable;
+
+        if (slot <= next)
+            reachable = slot < home && home <= next;
+        else
+            reachable = slot < home || home <= next;
+
+        if (!reachable)
+        {
+            entries[slot] = entries[next];
+            entries[next].handle = None;
+            entries[next].window = NULL;
+            slot = next;
+        }
+    }
+}
+
+// Returns the window with the specified XID, or NULL if there is none
+//
+static _GLFWwindow* findWindowByHandle(Window handle)
+{
+    // Events tend to arrive in runs for the same window
+    if (_glfw.x11.windowMap.lastHandle == handle)
+        return _glfw.x11.windowMap.lastWindow;
+
+    const _GLFWwindowmapX11* entries = _glfw.x11.windowMap.entries;
+    if (!entries || handle == None)
+        return NULL;
+
+    int slot = getWindowMapSlot(handle);
+    while (entries[slot].handle != handle)
+    {
+        if (!entries[slot].handle)
+            return NULL;
+
+        slot = (slot + 1) & (_glfw.x11.windowMap.size - 1);
+    }
+
+    _glfw.x11.windowMap.lastHandle = handle;
+    _glfw.x11.windowMap.lastWindow = entries[slot].window;
+    return entries[slot].window;
+}
+
+// Returns the event mask needed for the current callbacks and input modes
+//
+static long getEventMask(_GLFWwindow* window)
+{
+    // These events are needed to track window, key and button state even when
+    // no callbacks are set
+    long mask = StructureNotifyMask | KeyPressMask | KeyReleaseMask |
+                ButtonPressMask | ButtonReleaseMask | FocusChangeMask |
+                VisibilityChangeMask | PropertyChangeMask;
+
+    // NOTE: Disabled cursor mode with raw motion gets its motion from the XI2
+    //       raw events and needs no pointer motion events to re-center
+    if (window->callbacks.cursorPos ||
+        (window->cursorMode == GLFW_CURSOR_DISABLED && !window->rawMouseMotion))
+    {
+        mask |= PointerMotionMask;
+    }
+
+    if (window->callbacks.cursorEnter ||
+        window->callbacks.cursorPos ||
+        window->cursorMode != GLFW_CURSOR_NORMAL)
+    {
+        mask |= EnterWindowMask | LeaveWindowMask;
+    }
+
+    if (window->callbacks.refresh)
+        mask |= ExposureMask;
+
+    return mask | window->x11.filterMask;
+}
+
+// Selects only the events needed for the current callbacks and input modes
+//
+static void updateEventMask(_GLFWwindow* window)
+{
+    const long mask = getEventMask(window);
+    if (mask == window->x11.eventMask)
+        return;
+
+    // Crossing events may have been missed while they were not selected
+    if (!(window->x11.eventMask & PointerMotionMask) ||
+        !(window->x11.eventMask & LeaveWindowMask))
+    {
+        window->x11.cursorInside = GLFW_FALSE;
+    }
+
+    XSelectInput(_glfw.x11.display, window->x11.handle, mask);
+    window->x11.eventMask = mask;
+}
+
+// Replaces the specified motion event with the last of any directly following
+// queued motion events for the same window
+//
+static void compressMotionEvents(XEvent* event)
+{
+    // NOTE: Disabled cursor mode without raw motion needs every event to tell
+    //       motion caused by its cursor warps apart from user motion
+    const _GLFWwindow* window = _glfw.x11.disabledCursorWindow;
+    if (window && window->x11.handle == event->xmotion.window &&
+        !window->rawMouseMotion)
+    {
+        return;
+    }
+
+    while (QLength(_glfw.x11.display))
+    {
+        XEvent next;
+        XPeekEvent(_glfw.x11.display, &next);
+
+        if (next.type != MotionNotify ||
+            next.xmotion.window != event->xmotion.window)
+        {
+            break;
+        }
+
+        XNextEvent(_glfw.x11.display, event);
+    }
+}
+
+// Looks up the root position of the parent of a reparented window and updates
+// the window position from it
+//
+static void updateParentPosition(_GLFWwindow* window)
+{
+    int parentRootX, parentRootY;
+    Window dummy;
+
+    _glfwGrabErrorHandlerX11();
+
+    XTranslateCoordinates(_glfw.x11.display,
+                          window->x11.parent,
+                          _glfw.x11.root,
+                          0, 0,
+                          &parentRootX, &parentRootY,
+                          &dummy);
+
+    _glfwReleaseErrorHandlerX11();
+    if (_glfw.x11.errorCode == BadWindow)
+        return;
+
+    window->x11.parentRootX = parentRootX;
+    window->x11.parentRootY = parentRootY;
+    window->x11.parentRootKnown = GLFW_TRUE;
+
+    const int xpos = parentRootX + window->x11.parentOffsetX;
+    const int ypos = parentRootY + window->x11.parentOffsetY;
+
+    if (xpos != window->x11.xpos || ypos != window->x11.ypos)
+    {
+        window->x11.xpos = xpos;
+        window->x11.ypos = ypos;
+        window->x11.posChanged = GLFW_TRUE;
+    }
+}
+
+// Reports the size and position changes accumulated since the last poll
+//
+static void reportConfigureChanges(void)
+{
+    if (!_glfw.x11.configurePending)
+        return;
+
+    _glfw.x11.configurePending = GLFW_FALSE;
+
+    _GLFWwindow* window = _glfw.windowListHead;
+    while (window)
+    {
+        // The parent position is looked up at most once per poll, however many
+        // events from the server arrived while it was unknown
+        if (!window->x11.parentRootKnown && window->x11.parent != _glfw.x11.root)
+            updateParentPosition(window);
+
+        if (!window->x11.sizeChanged && !window->x11.posChanged)
+        {
+            window = window->next;
+            continue;
+        }
+
+        const GLFWbool sizeChanged = window->x11.sizeChanged;
+        const GLFWbool posChanged = window->x11.posChanged;
+        window->x11.sizeChanged = GLFW_FALSE;
+        window->x11.posChanged = GLFW_FALSE;
+
+        if (sizeChanged)
+        {
+            _glfwInputFramebufferSize(window, window->x11.width, window->x11.height);
+            _glfwInputWindowSize(window, window->x11.width, window->x11.height);
+        }
+
+        if (posChanged)
+            _glfwInputWindowPos(window, window->x11.xpos, window->x11.ypos);
+
+        // The callbacks may have destroyed any window, so start over
+        window = _glfw.windowListHead;
+    }
+}
+
+// Brings the event masks of all windows up to date
+// Callbacks are set by shared code, so this is done before events are read
+//
+static void updateEventMasks(void)
+{
+    for (_GLFWwindow* window = _glfw.windowListHead;  window;  window = window->next)
+        updateEventMask(window);
+}
+
 // Updates the cursor image according to its cursor mode
 //
 static void updateCursorImage(_GLFWwindow* window)
@@ -550,6 +836,24 @@ static void disableRawMouseMotion(_GLFWwindow* window)
     XISelectEvents(_glfw.x11.display, _glfw.x11.root, &em, 1);
 }
 
+// Confines the pointer to the disabled cursor window
+//
+static void grabPointer(_GLFWwindow* window)
+{
+    unsigned int mask = ButtonPressMask | ButtonReleaseMask;
+
+    // The raw motion events keep arriving while the pointer rests against the
+    // edge of the confining window, so only warping needs motion events
+    if (!window->rawMouseMotion)
+        mask |= PointerMotionMask;
+
+    XGrabPointer(_glfw.x11.display, window->x11.handle, True, mask,
+                 GrabModeAsync, GrabModeAsync,
+                 window->x11.handle,
+                 _glfw.x11.hiddenCursorHandle,
+                 CurrentTime);
+}
+
 // Apply disabled cursor mode to a focused window
 //
 static void disableCursor(_GLFWwindow* window)
@@ -563,12 +867,7 @@ static void disableCursor(_GLFWwindow* window)
                          &_glfw.x11.restoreCursorPosY);
     updateCursorImage(window);
     _glfwCenterCursorInContentArea(window);
-    XGrabPointer(_glfw.x11.display, window->x11.handle, True,
-                 ButtonPressMask | ButtonReleaseMask | PointerMotionMask,
-                 GrabModeAsync, GrabModeAsync,
-                 window->x11.handle,
-                 _glfw.x11.hiddenCursorHandle,
-                 CurrentTime);
+    grabPointer(window);
 }
 
 // Exit disabled cursor mode for the specified window
@@ -619,10 +918,7 @@ static GLFWbool createNativeWindow(_GLFWwindow* window,
 
     XSetWindowAttributes wa = { 0 };
     wa.colormap = window->x11.colormap;
-    wa.event_mask = StructureNotifyMask | KeyPressMask | KeyReleaseMask |
-                    PointerMotionMask | ButtonPressMask | ButtonReleaseMask |
-                    ExposureMask | FocusChangeMask | VisibilityChangeMask |
-                    EnterWindowMask | LeaveWindowMask | PropertyChangeMask;
+    wa.event_mask = getEventMask(window);
 
     _glfwGrabErrorHandlerX11();
 
@@ -647,10 +943,10 @@ static GLFWbool createNativeWindow(_GLFWwindow* window,
         return GLFW_FALSE;
     }
 
-    XSaveContext(_glfw.x11.display,
-                 window->x11.handle,
-                 _glfw.x11.context,
-                 (XPointer) window);
+    window->x11.eventMask = wa.event_mask;
+
+    if (!addWindowMapEntry(window))
+        return GLFW_FALSE;
 
     if (!wndconfig->decorated)
         _glfwSetWindowDecoratedX11(window, GLFW_FALSE);
@@ -776,8 +1072,18 @@ static GLFWbool createNativeWindow(_GLFWwindow* window,
         _glfwCreateInputContextX11(window);
 
     _glfwSetWindowTitleX11(window, wndconfig->title);
-    _glfwGetWindowPosX11(window, &window->x11.xpos, &window->x11.ypos);
-    _glfwGetWindowSizeX11(window, &window->x11.width, &window->x11.height);
+
+    // Seed the cached geometry from the window, as no ConfigureNotify will be
+    // sent until something changes it
+    Window dummy;
+    XTranslateCoordinates(_glfw.x11.display, window->x11.handle, _glfw.x11.root,
+                          0, 0, &window->x11.xpos, &window->x11.ypos, &dummy);
+
+    window->x11.parentRootX = 0;
+    window->x11.parentRootY = 0;
+    window->x11.parentRootKnown = GLFW_TRUE;
+    window->x11.width = width;
+    window->x11.height = height;
 
     return GLFW_TRUE;
 }
@@ -1070,80 +1376,421 @@ static const char* getSelectionString(Atom selection)
                 *selectionString = _glfw_strdup(data);
         }
 
-        XFree(data);
+        XFree(data);
+
+        if (*selectionString)
+            break;
+    }
+
+    if (!*selectionString)
+    {
+        _glfwInputError(GLFW_FORMAT_UNAVAILABLE,
+                        "X11: Failed to convert selection to string");
+    }
+
+    return *selectionString;
+}
+
+// Make the specified window and its video mode active on its monitor
+//
+static void acquireMonitor(_GLFWwindow* window)
+{
+    if (_glfw.x11.saver.count == 0)
+    {
+        // Remember old screen saver settings
+        XGetScreenSaver(_glfw.x11.display,
+                        &_glfw.x11.saver.timeout,
+                        &_glfw.x11.saver.interval,
+                        &_glfw.x11.saver.blanking,
+                        &_glfw.x11.saver.exposure);
+
+        // Disable screen saver
+        XSetScreenSaver(_glfw.x11.display, 0, 0, DontPreferBlanking,
+                        DefaultExposures);
+    }
+
+    if (!window->monitor->window)
+        _glfw.x11.saver.count++;
+
+    _glfwSetVideoModeX11(window->monitor, &window->videoMode);
+
+    if (window->x11.overrideRedirect)
+    {
+        int xpos, ypos;
+        GLFWvidmode mode;
+
+        // Manually position the window over its monitor
+        _glfwGetMonitorPosX11(window->monitor, &xpos, &ypos);
+        _glfwGetVideoModeX11(window->monitor, &mode);
+
+        XMoveResizeWindow(_glfw.x11.display, window->x11.handle,
+                          xpos, ypos, mode.width, mode.height);
+    }
+
+    _glfwInputMonitorWindow(window->monitor, window);
+}
+
+// Remove the window and restore the original video mode
+//
+static void releaseMonitor(_GLFWwindow* window)
+{
+    if (window->monitor->window != window)
+        return;
+
+    _glfwInputMonitorWindow(window->monitor, NULL);
+    _glfwRestoreVideoModeX11(window->monitor);
+
+    _glfw.x11.saver.count--;
+
+    if (_glfw.x11.saver.count == 0)
+    {
+        // Restore old screen saver settings
+        XSetScreenSaver(_glfw.x11.display,
+                        _glfw.x11.saver.timeout,
+                        _glfw.x11.saver.interval,
+                        _glfw.x11.saver.blanking,
+                        _glfw.x11.saver.exposure);
+    }
+}
+
+// Returns whether the specified images are those of the cached icon
+//
+static GLFWbool matchIconCache(int count, const GLFWimage* images, uint64_t hash)
+{
+    if (!_glfw.x11.icon.data || _glfw.x11.icon.hash != hash)
+        return GLFW_FALSE;
+
+    const unsigned long* data = _glfw.x11.icon.data;
+    const unsigned long* end = data + _glfw.x11.icon.longCount;
+    const unsigned char* pixels = _glfw.x11.icon.pixels;
+
+    for (int i = 0;  i < count;  i++)
+    {
+        const size_t size = (size_t) images[i].width * images[i].height * 4;
+
+        if (end - data < 2 ||
+            data[0] != (unsigned long) images[i].width ||
+            data[1] != (unsigned long) images[i].height ||
+            memcmp(pixels, images[i].pixels, size) != 0)
+        {
+            return GLFW_FALSE;
+        }
+
+        data += 2 + size / 4;
+        pixels += size;
+    }
+
+    return data == end;
+}
+
+// Replaces the cached icon with the specified images
+//
+static void updateIconCache(int count, const GLFWimage* images, uint64_t hash)
+{
+    int longCount = 0;
+
+    for (int i = 0;  i < count;  i++)
+        longCount += 2 + images[i].width * images[i].height;
+
+    _glfw_free(_glfw.x11.icon.data);
+    _glfw_free(_glfw.x11.icon.pixels);
+
+    unsigned long* icon = _glfw_calloc(longCount, sizeof(unsigned long));
+    unsigned char* pixels = _glfw_calloc(longCount - count * 2, 4);
+    unsigned long* target = icon;
+
+    _glfw.x11.icon.hash = hash;
+    _glfw.x11.icon.data = icon;
+    _glfw.x11.icon.pixels = pixels;
+    _glfw.x11.icon.longCount = longCount;
+
+    // Zero means that a window has no icon from the cache
+    if (++_glfw.x11.icon.serial == 0)
+        _glfw.x11.icon.serial = 1;
+
+    for (int i = 0;  i < count;  i++)
+    {
+        const int pixelCount = images[i].width * images[i].height;
+
+        *target++ = images[i].width;
+        *target++ = images[i].height;
+
+        // Convert in chunks of 32-bit words and then widen them to longs
+        for (int j = 0;  j < pixelCount;  j += 256)
+        {
+            uint32_t chunk[256];
+            const int length = pixelCount - j < 256 ? pixelCount - j : 256;
+
+            _glfwConvertPixels(chunk, images[i].pixels + j * 4, length,
+                               _GLFW_PIXELS_ARGB32);
+
+            for (int k = 0;  k < length;  k++)
+                *target++ = chunk[k];
+        }
+
+        memcpy(pixels, images[i].pixels, (size_t) pixelCount * 4);
+        pixels += (size_t) pixelCount * 4;
+    }
+}
+
+// Returns the bit offset of the lowest set bit of the specified mask
+//
+static int maskShift(unsigned long mask)
+{
+    int shift = 0;
+
+    while (mask && !(mask & 1))
+    {
+        mask >>= 1;
+        shift++;
+    }
+
+    return shift;
+}
+
+// Destroys the images used by glfwPresentPixels
+//
+static void destroyPresentImages(_GLFWwindow* window)
+{
+    for (int i = 0;  i < 2;  i++)
+    {
+        XImage* image = window->x11.presentImages[i];
+        if (!image)
+            continue;
+
+        if (window->x11.presentShared)
+        {
+            // NOTE: The detach request is processed after any pending put, and
+            //       the segment goes away once both sides have detached
+            XShmDetach(_glfw.x11.display, &window->x11.presentSegments[i]);
+            shmdt(window->x11.presentSegments[i].shmaddr);
+        }
+        else
+            _glfw_free(image->data);
+
+        image->data = NULL;
+        XDestroyImage(image);
+
+        window->x11.presentImages[i] = NULL;
+        window->x11.presentPending[i] = 0;
+    }
+}
+
+// Creates a shared memory image and attaches it to the server
+//
+static GLFWbool createSharedImage(_GLFWwindow* window, int index,
+                                  Visual* visual, int depth,
+                                  int width, int height)
+{
+    XShmSegmentInfo* segment = &window->x11.presentSegments[index];
+
+    XImage* image = XShmCreateImage(_glfw.x11.display, visual, depth, ZPixmap,
+                                    NULL, segment, width, height);
+    if (!image)
+        return GLFW_FALSE;
+
+    segment->shmid = shmget(IPC_PRIVATE,
+                            (size_t) image->bytes_per_line * image->height,
+                            IPC_CREAT | 0600);
+    if (segment->shmid == -1)
+    {
+        XDestroyImage(image);
+        return GLFW_FALSE;
+    }
 
-        if (*selectionString)
-            break;
+    segment->shmaddr = shmat(segment->shmid, NULL, 0);
+    segment->readOnly = True;
+
+    if (segment->shmaddr == (char*) -1)
+    {
+        shmctl(segment->shmid, IPC_RMID, NULL);
+        XDestroyImage(image);
+        return GLFW_FALSE;
     }
 
-    if (!*selectionString)
+    _glfwGrabErrorHandlerX11();
+    XShmAttach(_glfw.x11.display, segment);
+    _glfwReleaseErrorHandlerX11();
+
+    // The segment is destroyed once both the server and GLFW have detached
+    shmctl(segment->shmid, IPC_RMID, NULL);
+
+    if (_glfw.x11.errorCode != Success)
     {
-        _glfwInputError(GLFW_FORMAT_UNAVAILABLE,
-                        "X11: Failed to convert selection to string");
+        // NOTE: This happens when the server is not on the same machine
+        shmdt(segment->shmaddr);
+        XDestroyImage(image);
+        _glfw.x11.xshm.available = GLFW_FALSE;
+        return GLFW_FALSE;
     }
 
-    return *selectionString;
+    image->data = segment->shmaddr;
+    window->x11.presentImages[index] = image;
+    return GLFW_TRUE;
 }
 
-// Make the specified window and its video mode active on its monitor
+// Creates the images used by glfwPresentPixels for the specified size
 //
-static void acquireMonitor(_GLFWwindow* window)
+static GLFWbool createPresentImages(_GLFWwindow* window, int width, int height)
 {
-    if (_glfw.x11.saver.count == 0)
+    XWindowAttributes attribs;
+    XGetWindowAttributes(_glfw.x11.display, window->x11.handle, &attribs);
+
+    const unsigned long masks[3] =
     {
-        // Remember old screen saver settings
-        XGetScreenSaver(_glfw.x11.display,
-                        &_glfw.x11.saver.timeout,
-                        &_glfw.x11.saver.interval,
-                        &_glfw.x11.saver.blanking,
-                        &_glfw.x11.saver.exposure);
+        attribs.visual->red_mask,
+        attribs.visual->green_mask,
+        attribs.visual->blue_mask
+    };
+    const unsigned long channels = masks[0] | masks[1] | masks[2];
 
-        // Disable screen saver
-        XSetScreenSaver(_glfw.x11.display, 0, 0, DontPreferBlanking,
-                        DefaultExposures);
+    if (attribs.visual->class != TrueColor ||
+        masks[0] >> maskShift(masks[0]) != 0xff ||
+        masks[1] >> maskShift(masks[1]) != 0xff ||
+        masks[2] >> maskShift(masks[2]) != 0xff)
+    {
+        _glfwInputError(GLFW_FEATURE_UNAVAILABLE,
+                        "X11: Software presentation requires a visual with eight bits per channel");
+        return GLFW_FALSE;
     }
 
-    if (!window->monitor->window)
-        _glfw.x11.saver.count++;
+    if (!window->x11.presentGC)
+    {
+        window->x11.presentGC =
+            XCreateGC(_glfw.x11.display, window->x11.handle, 0, NULL);
+    }
 
-    _glfwSetVideoModeX11(window->monitor, &window->videoMode);
+    window->x11.presentShared = GLFW_FALSE;
 
-    if (window->x11.overrideRedirect)
+    if (_glfw.hints.init.x11.sharedMemory && _glfwLoadXShmX11())
     {
-        int xpos, ypos;
-        GLFWvidmode mode;
+        window->x11.presentShared = GLFW_TRUE;
 
-        // Manually position the window over its monitor
-        _glfwGetMonitorPosX11(window->monitor, &xpos, &ypos);
-        _glfwGetVideoModeX11(window->monitor, &mode);
+        for (int i = 0;  i < 2;  i++)
+        {
+            if (!createSharedImage(window, i, attribs.visual, attribs.depth,
+                                   width, height))
+            {
+                destroyPresentImages(window);
+                window->x11.presentShared = GLFW_FALSE;
+                break;
+            }
+        }
+    }
 
-        XMoveResizeWindow(_glfw.x11.display, window->x11.handle,
-                          xpos, ypos, mode.width, mode.height);
+    if (!window->x11.presentShared)
+    {
+        // Convert and upload in bands of rows to keep the buffer small
+        int rows = (256 * 1024) / (width * 4);
+        if (rows < 1)
+            rows = 1;
+        if (rows > height)
+            rows = height;
+
+        XImage* image = XCreateImage(_glfw.x11.display,
+                                     attribs.visual, attribs.depth,
+                                     ZPixmap, 0, NULL, width, rows, 32, 0);
+        if (!image)
+        {
+            _glfwInputError(GLFW_PLATFORM_ERROR,
+                            "X11: Failed to create image for software presentation");
+            return GLFW_FALSE;
+        }
+
+        image->data = _glfw_calloc(image->bytes_per_line, rows);
+        window->x11.presentImages[0] = image;
     }
 
-    _glfwInputMonitorWindow(window->monitor, window);
+    if (window->x11.presentImages[0]->bits_per_pixel != 32)
+    {
+        _glfwInputError(GLFW_FEATURE_UNAVAILABLE,
+                        "X11: Software presentation requires a 32-bit pixel format");
+        destroyPresentImages(window);
+        return GLFW_FALSE;
+    }
+
+    // The pixels are written in host byte order and Xlib converts them for
+    // the server if needed
+    for (int i = 0;  i < 2;  i++)
+    {
+        const unsigned int one = 1;
+        if (window->x11.presentImages[i])
+        {
+            window->x11.presentImages[i]->byte_order =
+                *(const unsigned char*) &one ? LSBFirst : MSBFirst;
+        }
+    }
+
+    window->x11.presentShifts[0] = maskShift(masks[0]);
+    window->x11.presentShifts[1] = maskShift(masks[1]);
+    window->x11.presentShifts[2] = maskShift(masks[2]);
+    window->x11.presentShifts[3] = maskShift(~channels & 0xffffffff);
+    window->x11.presentIndex = 0;
+    window->x11.presentWidth = width;
+    window->x11.presentHeight = height;
+    return GLFW_TRUE;
 }
 
-// Remove the window and restore the original video mode
+// Converts RGBA pixels into the pixel format of the specified image
 //
-static void releaseMonitor(_GLFWwindow* window)
+static void convertPixels(_GLFWwindow* window, XImage* image, int x, int y,
+                          const unsigned char* source, int stride,
+                          int width, int height)
 {
-    if (window->monitor->window != window)
-        return;
+    const int rs = window->x11.presentShifts[0];
+    const int gs = window->x11.presentShifts[1];
+    const int bs = window->x11.presentShifts[2];
+    const int as = window->x11.presentShifts[3];
+    // This is the layout of nearly every 24 and 32-bit TrueColor visual
+    const GLFWbool argb = rs == 16 && gs == 8 && bs == 0 && as == 24;
+    // Compositors treat the ARGB visuals of transparent windows as having
+    // premultiplied alpha, while opaque visuals ignore the alpha channel
+    const GLFWbool premultiplied = window->x11.transparent;
+
+    for (int row = 0;  row < height;  row++)
+    {
+        const unsigned char* s = source + (size_t) stride * row;
+        uint32_t* d = (uint32_t*) (image->data +
+                                   (size_t) image->bytes_per_line * (y + row)) + x;
 
-    _glfwInputMonitorWindow(window->monitor, NULL);
-    _glfwRestoreVideoModeX11(window->monitor);
+        if (argb)
+        {
+            _glfwConvertPixels(d, s, width, premultiplied ?
+                               _GLFW_PIXELS_ARGB32 | _GLFW_PIXELS_PREMULTIPLIED :
+                               _GLFW_PIXELS_ARGB32);
+            continue;
+        }
 
-    _glfw.x11.saver.count--;
+        for (int i = 0;  i < width;  i++, s += 4)
+        {
+            uint32_t r = s[0], g = s[1], b = s[2];
+            const uint32_t a = s[3];
 
-    if (_glfw.x11.saver.count == 0)
+            if (premultiplied)
+            {
+                r = (r * a + 1 + ((r * a) >> 8)) >> 8;
+                g = (g * a + 1 + ((g * a) >> 8)) >> 8;
+                b = (b * a + 1 + ((b * a) >> 8)) >> 8;
+            }
+
+            d[i] = (r << rs) | (g << gs) | (b << bs) | (a << as);
+        }
+    }
+}
+
+// Notes that the server has finished reading a shared memory image
+//
+static void handleShmCompletion(_GLFWwindow* window,
+                                const XShmCompletionEvent* event)
+{
+    for (int i = 0;  i < 2;  i++)
     {
-        // Restore old screen saver settings
-        XSetScreenSaver(_glfw.x11.display,
-                        _glfw.x11.saver.timeout,
-                        _glfw.x11.saver.interval,
-                        _glfw.x11.saver.blanking,
-                        _glfw.x11.saver.exposure);
+        if (window->x11.presentImages[i] &&
+            window->x11.presentSegments[i].shmseg == event->shmseg &&
+            window->x11.presentPending[i] > 0)
+        {
+            window->x11.presentPending[i]--;
+        }
     }
 }
 
@@ -1200,19 +1847,18 @@ static void processEvent(XEvent *event)
                 if (re->valuators.mask_len)
                 {
                     const double* values = re->raw_values;
-                    double xpos = window->virtualCursorPosX;
-                    double ypos = window->virtualCursorPosY;
+                    double dx = 0.0, dy = 0.0;
 
                     if (XIMaskIsSet(re->valuators.mask, 0))
                     {
-                        xpos += *values;
+                        dx = *values;
                         values++;
                     }
 
                     if (XIMaskIsSet(re->valuators.mask, 1))
-                        ypos += *values;
+                        dy = *values;
 
-                    _glfwInputCursorPos(window, xpos, ypos);
+                    _glfwInputRawMouseMotion(window, dx, dy);
                 }
             }
 
@@ -1233,21 +1879,39 @@ static void processEvent(XEvent *event)
         return;
     }
 
-    _GLFWwindow* window = NULL;
-    if (XFindContext(_glfw.x11.display,
-                     event->xany.window,
-                     _glfw.x11.context,
-                     (XPointer*) &window) != 0)
+    _GLFWwindow* window = findWindowByHandle(event->xany.window);
+    if (!window)
     {
         // This is an event for a window that has already been destroyed
         return;
     }
 
+    if (_glfw.x11.xshm.handle &&
+        event->type == _glfw.x11.xshm.eventBase + ShmCompletion)
+    {
+        handleShmCompletion(window, (XShmCompletionEvent*) event);
+        return;
+    }
+
     switch (event->type)
     {
         case ReparentNotify:
         {
             window->x11.parent = event->xreparent.parent;
+            window->x11.parentOffsetX = event->xreparent.x;
+            window->x11.parentOffsetY = event->xreparent.y;
+
+            // NOTE: The root position of the new parent is not known until the
+            //       WM sends a synthetic ConfigureNotify with root coordinates
+            if (window->x11.parent == _glfw.x11.root)
+            {
+                window->x11.parentRootX = 0;
+                window->x11.parentRootY = 0;
+                window->x11.parentRootKnown = GLFW_TRUE;
+            }
+            else
+                window->x11.parentRootKnown = GLFW_FALSE;
+
             return;
         }
 
@@ -1298,10 +1962,8 @@ static void processEvent(XEvent *event)
 
                     if (status == XLookupChars || status == XLookupBoth)
                     {
-                        const char* c = chars;
                         chars[count] = '\0';
-                        while (c - chars < count)
-                            _glfwInputChar(window, decodeUTF8(&c), mods, plain);
+                        _glfwInputText(window, chars, mods, plain);
                     }
 
                     if (chars != buffer)
@@ -1452,11 +2114,13 @@ static void processEvent(XEvent *event)
 
             window->x11.lastCursorPosX = x;
             window->x11.lastCursorPosY = y;
+            window->x11.cursorInside = GLFW_TRUE;
             return;
         }
 
         case LeaveNotify:
         {
+            window->x11.cursorInside = GLFW_FALSE;
             _glfwInputCursorEnter(window, GLFW_FALSE);
             return;
         }
@@ -1496,49 +2160,68 @@ static void processEvent(XEvent *event)
 
         case ConfigureNotify:
         {
-            if (event->xconfigure.width != window->x11.width ||
-                event->xconfigure.height != window->x11.height)
-            {
-                _glfwInputFramebufferSize(window,
-                                          event->xconfigure.width,
-                                          event->xconfigure.height);
-
-                _glfwInputWindowSize(window,
-                                     event->xconfigure.width,
-                                     event->xconfigure.height);
+            // NOTE: Size and position changes are reported once per poll, as
+            //       interactive moves and resizes can generate many events
+            const GLFWbool resized =
+                event->xconfigure.width != window->x11.width ||
+                event->xconfigure.height != window->x11.height;
 
+            if (resized)
+            {
                 window->x11.width = event->xconfigure.width;
                 window->x11.height = event->xconfigure.height;
+                window->x11.sizeChanged = GLFW_TRUE;
+                _glfw.x11.configurePending = GLFW_TRUE;
             }
 
             int xpos = event->xconfigure.x;
             int ypos = event->xconfigure.y;
 
-            // NOTE: ConfigureNotify events from the server are in local
-            //       coordinates, so if we are reparented we need to translate
-            //       the position into root (screen) coordinates
-            if (!event->xany.send_event && window->x11.parent != _glfw.x11.root)
+            if (window->x11.parent != _glfw.x11.root)
             {
-                _glfwGrabErrorHandlerX11();
-
-                Window dummy;
-                XTranslateCoordinates(_glfw.x11.display,
-                                      window->x11.parent,
-                                      _glfw.x11.root,
-                                      xpos, ypos,
-                                      &xpos, &ypos,
-                                      &dummy);
+                if (event->xany.send_event)
+                {
+                    // NOTE: Synthetic ConfigureNotify events from the WM are in
+                    //       root coordinates, which also tells us where our
+                    //       parent is
+                    window->x11.parentRootX = xpos - window->x11.parentOffsetX;
+                    window->x11.parentRootY = ypos - window->x11.parentOffsetY;
+                    window->x11.parentRootKnown = GLFW_TRUE;
+                }
+                else
+                {
+                    // NOTE: ConfigureNotify events from the server are in local
+                    //       coordinates, so if we are reparented we need to
+                    //       translate the position into root (screen) coordinates
+                    window->x11.parentOffsetX = xpos;
+                    window->x11.parentOffsetY = ypos;
+
+                    // NOTE: ICCCM sends no synthetic event when the window is
+                    //       moved and resized at the same time, for example by
+                    //       resizing it from the top or left edge, so after
+                    //       a resize the parent may have moved as well
+                    if (resized)
+                        window->x11.parentRootKnown = GLFW_FALSE;
+
+                    // The position is updated once the parent has been looked
+                    // up, unless a synthetic event tells us first
+                    if (!window->x11.parentRootKnown)
+                    {
+                        _glfw.x11.configurePending = GLFW_TRUE;
+                        return;
+                    }
 
-                _glfwReleaseErrorHandlerX11();
-                if (_glfw.x11.errorCode == BadWindow)
-                    return;
+                    xpos += window->x11.parentRootX;
+                    ypos += window->x11.parentRootY;
+                }
             }
 
             if (xpos != window->x11.xpos || ypos != window->x11.ypos)
             {
-                _glfwInputWindowPos(window, xpos, ypos);
                 window->x11.xpos = xpos;
                 window->x11.ypos = ypos;
+                window->x11.posChanged = GLFW_TRUE;
+                _glfw.x11.configurePending = GLFW_TRUE;
             }
 
             return;
@@ -1791,7 +2474,11 @@ static void processEvent(XEvent *event)
 
         case Expose:
         {
-            _glfwInputWindowDamage(window);
+            _glfwInputWindowDamageRect(window,
+                                       event->xexpose.x,
+                                       event->xexpose.y,
+                                       event->xexpose.width,
+                                       event->xexpose.height);
             return;
         }
 
@@ -1823,7 +2510,7 @@ static void processEvent(XEvent *event)
             }
             else if (event->xproperty.atom == _glfw.x11.NET_WM_STATE)
             {
-                const GLFWbool maximized = _glfwWindowMaximizedX11(window);
+                const GLFWbool maximized = getWindowMaximized(window);
                 if (window->x11.maximized != maximized)
                 {
                     window->x11.maximized = maximized;
@@ -1874,7 +2561,7 @@ unsigned long _glfwGetWindowPropertyX11(Window window,
 
 GLFWbool _glfwIsVisualTransparentX11(Visual* visual)
 {
-    if (!_glfw.x11.xrender.available)
+    if (!_glfwLoadXRenderX11())
         return GLFW_FALSE;
 
     XRenderPictFormat* pf = XRenderFindVisualFormat(_glfw.x11.display, visual);
@@ -1948,15 +2635,11 @@ void _glfwCreateInputContextX11(_GLFWwindow* window)
 
     if (window->x11.ic)
     {
-        XWindowAttributes attribs;
-        XGetWindowAttributes(_glfw.x11.display, window->x11.handle, &attribs);
-
         unsigned long filter = 0;
         if (XGetICValues(window->x11.ic, XNFilterEvents, &filter, NULL) == NULL)
         {
-            XSelectInput(_glfw.x11.display,
-                         window->x11.handle,
-                         attribs.your_event_mask | filter);
+            window->x11.filterMask = (long) filter;
+            updateEventMask(window);
         }
     }
 }
@@ -2053,9 +2736,17 @@ void _glfwDestroyWindowX11(_GLFWwindow* window)
     if (window->context.destroy)
         window->context.destroy(window);
 
+    destroyPresentImages(window);
+
+    if (window->x11.presentGC)
+    {
+        XFreeGC(_glfw.x11.display, window->x11.presentGC);
+        window->x11.presentGC = NULL;
+    }
+
     if (window->x11.handle)
     {
-        XDeleteContext(_glfw.x11.display, window->x11.handle, _glfw.x11.context);
+        removeWindowMapEntry(window->x11.handle);
         XUnmapWindow(_glfw.x11.display, window->x11.handle);
         XDestroyWindow(_glfw.x11.display, window->x11.handle);
         window->x11.handle = (Window) 0;
@@ -2098,47 +2789,38 @@ void _glfwSetWindowIconX11(_GLFWwindow* window, int count, const GLFWimage* imag
 {
     if (count)
     {
-        int longCount = 0;
+        uint64_t hash = count;
 
         for (int i = 0;  i < count;  i++)
-            longCount += 2 + images[i].width * images[i].height;
+            hash = _glfwHashImage(images + i, hash);
 
-        unsigned long* icon = _glfw_calloc(longCount, sizeof(unsigned long));
-        unsigned long* target = icon;
+        if (!matchIconCache(count, images, hash))
+            updateIconCache(count, images, hash);
 
-        for (int i = 0;  i < count;  i++)
-        {
-            *target++ = images[i].width;
-            *target++ = images[i].height;
-
-            for (int j = 0;  j < images[i].width * images[i].height;  j++)
-            {
-                *target++ = (((unsigned long) images[i].pixels[j * 4 + 0]) << 16) |
-                            (((unsigned long) images[i].pixels[j * 4 + 1]) <<  8) |
-                            (((unsigned long) images[i].pixels[j * 4 + 2]) <<  0) |
-                            (((unsigned long) images[i].pixels[j * 4 + 3]) << 24);
-            }
-        }
-
-        // NOTE: XChangeProperty expects 32-bit values like the image data above to be
+        // NOTE: XChangeProperty expects 32-bit values like the cached icon data to be
         //       placed in the 32 least significant bits of individual longs.  This is
         //       true even if long is 64-bit and a WM protocol calls for "packed" data.
         //       This is because of a historical mistake that then became part of the Xlib
         //       ABI.  Xlib will pack these values into a regular array of 32-bit values
         //       before sending it over the wire.
-        XChangeProperty(_glfw.x11.display, window->x11.handle,
-                        _glfw.x11.NET_WM_ICON,
-                        XA_CARDINAL, 32,
-                        PropModeReplace,
-                        (unsigned char*) icon,
-                        longCount);
+        if (window->x11.iconSerial != _glfw.x11.icon.serial)
+        {
+            XChangeProperty(_glfw.x11.display, window->x11.handle,
+                            _glfw.x11.NET_WM_ICON,
+                            XA_CARDINAL, 32,
+                            PropModeReplace,
+                            (unsigned char*) _glfw.x11.icon.data,
+                            _glfw.x11.icon.longCount);
 
-        _glfw_free(icon);
+            window->x11.iconSerial = _glfw.x11.icon.serial;
+        }
     }
     else
     {
         XDeleteProperty(_glfw.x11.display, window->x11.handle,
                         _glfw.x11.NET_WM_ICON);
+
+        window->x11.iconSerial = 0;
     }
 
     XFlush(_glfw.x11.display);
@@ -2146,16 +2828,10 @@ void _glfwSetWindowIconX11(_GLFWwindow* window, int count, const GLFWimage* imag
 
 void _glfwGetWindowPosX11(_GLFWwindow* window, int* xpos, int* ypos)
 {
-    Window dummy;
-    int x, y;
-
-    XTranslateCoordinates(_glfw.x11.display, window->x11.handle, _glfw.x11.root,
-                          0, 0, &x, &y, &dummy);
-
     if (xpos)
-        *xpos = x;
+        *xpos = window->x11.xpos;
     if (ypos)
-        *ypos = y;
+        *ypos = window->x11.ypos;
 }
 
 void _glfwSetWindowPosX11(_GLFWwindow* window, int xpos, int ypos)
@@ -2179,18 +2855,27 @@ void _glfwSetWindowPosX11(_GLFWwindow* window, int xpos, int ypos)
     }
 
     XMoveWindow(_glfw.x11.display, window->x11.handle, xpos, ypos);
+
+    // NOTE: The cached position is updated now like the size, so position
+    //       queries see the requested position, and the change is reported at
+    //       next poll
+    if (xpos != window->x11.xpos || ypos != window->x11.ypos)
+    {
+        window->x11.xpos = xpos;
+        window->x11.ypos = ypos;
+        window->x11.posChanged = GLFW_TRUE;
+        _glfw.x11.configurePending = GLFW_TRUE;
+    }
+
     XFlush(_glfw.x11.display);
 }
 
 void _glfwGetWindowSizeX11(_GLFWwindow* window, int* width, int* height)
 {
-    XWindowAttributes attribs;
-    XGetWindowAttributes(_glfw.x11.display, window->x11.handle, &attribs);
-
     if (width)
-        *width = attribs.width;
+        *width = window->x11.width;
     if (height)
-        *height = attribs.height;
+        *height = window->x11.height;
 }
 
 void _glfwSetWindowSizeX11(_GLFWwindow* window, int width, int height)
@@ -2206,6 +2891,17 @@ void _glfwSetWindowSizeX11(_GLFWwindow* window, int width, int height)
             updateNormalHints(window, width, height);
 
         XResizeWindow(_glfw.x11.display, window->x11.handle, width, height);
+
+        // NOTE: The cached size is updated now rather than by the ConfigureNotify
+        //       so that size queries and the size hints set by other functions
+        //       see the requested size, and the change is reported at next poll
+        if (width != window->x11.width || height != window->x11.height)
+        {
+            window->x11.width = width;
+            window->x11.height = height;
+            window->x11.sizeChanged = GLFW_TRUE;
+            _glfw.x11.configurePending = GLFW_TRUE;
+        }
     }
 
     XFlush(_glfw.x11.display);
@@ -2329,7 +3025,9 @@ void _glfwRestoreWindowX11(_GLFWwindow* window)
         return;
     }
 
-    if (_glfwWindowIconifiedX11(window))
+    // NOTE: The window state is queried here, as the cached iconification is
+    //       not updated until the WM_STATE change has been processed
+    if (getWindowState(window) == IconicState)
     {
         XMapWindow(_glfw.x11.display, window->x11.handle);
         waitForVisibilityNotify(window);
@@ -2526,7 +3224,7 @@ int _glfwWindowFocusedX11(_GLFWwindow* window)
 
 int _glfwWindowIconifiedX11(_GLFWwindow* window)
 {
-    return getWindowState(window) == IconicState;
+    return window->x11.iconified;
 }
 
 int _glfwWindowVisibleX11(_GLFWwindow* window)
@@ -2538,36 +3236,7 @@ int _glfwWindowVisibleX11(_GLFWwindow* window)
 
 int _glfwWindowMaximizedX11(_GLFWwindow* window)
 {
-    Atom* states;
-    GLFWbool maximized = GLFW_FALSE;
-
-    if (!_glfw.x11.NET_WM_STATE ||
-        !_glfw.x11.NET_WM_STATE_MAXIMIZED_VERT ||
-        !_glfw.x11.NET_WM_STATE_MAXIMIZED_HORZ)
-    {
-        return maximized;
-    }
-
-    const unsigned long count =
-        _glfwGetWindowPropertyX11(window->x11.handle,
-                                  _glfw.x11.NET_WM_STATE,
-                                  XA_ATOM,
-                                  (unsigned char**) &states);
-
-    for (unsigned long i = 0;  i < count;  i++)
-    {
-        if (states[i] == _glfw.x11.NET_WM_STATE_MAXIMIZED_VERT ||
-            states[i] == _glfw.x11.NET_WM_STATE_MAXIMIZED_HORZ)
-        {
-            maximized = GLFW_TRUE;
-            break;
-        }
-    }
-
-    if (states)
-        XFree(states);
-
-    return maximized;
+    return window->x11.maximized;
 }
 
 int _glfwWindowHoveredX11(_GLFWwindow* window)
@@ -2704,7 +3373,7 @@ void _glfwSetWindowFloatingX11(_GLFWwindow* window, GLFWbool enabled)
 
 void _glfwSetWindowMousePassthroughX11(_GLFWwindow* window, GLFWbool enabled)
 {
-    if (!_glfw.x11.xshape.available)
+    if (!_glfwLoadXShapeX11())
         return;
 
     if (enabled)
@@ -2721,6 +3390,90 @@ void _glfwSetWindowMousePassthroughX11(_GLFWwindow* window, GLFWbool enabled)
     }
 }
 
+unsigned char* _glfwGetWindowPixelsX11(_GLFWwindow* window, int* stride)
+{
+    _glfwInputError(GLFW_FEATURE_UNAVAILABLE,
+                    "X11: Software framebuffers are not supported");
+    return NULL;
+}
+
+void _glfwSwapWindowPixelsX11(_GLFWwindow* window)
+{
+}
+
+void _glfwPresentPixelsX11(_GLFWwindow* window,
+                           const unsigned char* pixels,
+                           int stride, int width, int height,
+                           const GLFWrect* area)
+{
+    if (!window->x11.presentImages[0] ||
+        window->x11.presentWidth != width ||
+        window->x11.presentHeight != height)
+    {
+        destroyPresentImages(window);
+
+        if (!createPresentImages(window, width, height))
+            return;
+    }
+
+    const unsigned char* source = pixels + (size_t) stride * area->y + area->x * 4;
+
+    if (window->x11.presentShared)
+    {
+        const int index = window->x11.presentIndex;
+
+        if (window->x11.presentPending[index])
+        {
+            // Wait for the server to finish reading the image from the last
+            // time it was used, which means a roundtrip
+            XEvent event;
+            XSync(_glfw.x11.display, False);
+
+            while (XCheckTypedWindowEvent(_glfw.x11.display,
+                                          window->x11.handle,
+                                          _glfw.x11.xshm.eventBase + ShmCompletion,
+                                          &event))
+            {
+                handleShmCompletion(window, (XShmCompletionEvent*) &event);
+            }
+        }
+
+        XImage* image = window->x11.presentImages[index];
+        convertPixels(window, image, area->x, area->y, source, stride,
+                      area->width, area->height);
+
+        XShmPutImage(_glfw.x11.display, window->x11.handle,
+                     window->x11.presentGC, image,
+                     area->x, area->y, area->x, area->y,
+                     area->width, area->height, True);
+
+        window->x11.presentPending[index]++;
+        window->x11.presentIndex = index ^ 1;
+    }
+    else
+    {
+        XImage* image = window->x11.presentImages[0];
+
+        for (int y = 0;  y < area->height;  y += image->height)
+        {
+            int rows = area->height - y;
+            if (rows > image->height)
+                rows = image->height;
+
+            convertPixels(window, image, area->x, 0,
+                          source + (size_t) stride * y, stride,
+                          area->width, rows);
+
+            XPutImage(_glfw.x11.display, window->x11.handle,
+                      window->x11.presentGC, image,
+                      area->x, 0, area->x, area->y + y,
+                      area->width, rows);
+        }
+    }
+
+    XFlush(_glfw.x11.display);
+}
+
 float _glfwGetWindowOpacityX11(_GLFWwindow* window)
 {
     float opacity = 1.f;
@@ -2763,17 +3516,30 @@ void _glfwSetRawMouseMotionX11(_GLFWwindow *window, GLFWbool enabled)
     if (enabled)
         enableRawMouseMotion(window);
     else
+    {
         disableRawMouseMotion(window);
+
+        // The warp path computes deltas from the last pointer motion event,
+        // which has not been selected while raw motion was enabled
+        _glfwCenterCursorInContentArea(window);
+    }
+
+    grabPointer(window);
+    updateEventMask(window);
+    XFlush(_glfw.x11.display);
 }
 
 GLFWbool _glfwRawMouseMotionSupportedX11(void)
 {
-    return _glfw.x11.xi.available;
+    return _glfwLoadXInputX11();
 }
 
 void _glfwPollEventsX11(void)
 {
-    drainEmptyEvents();
+    _glfwDrainWakePOSIX(&_glfw.x11.emptyEventWake);
+    _glfwCheckWatchesPOSIX();
+
+    updateEventMasks();
 
 #if defined(__linux__)
     if (_glfw.joysticksInitialized)
@@ -2785,11 +3551,19 @@ void _glfwPollEventsX11(void)
     {
         XEvent event;
         XNextEvent(_glfw.x11.display, &event);
+
+        if (event.type == MotionNotify && _glfw.hints.init.x11.motionCompression)
+            compressMotionEvents(&event);
+
         processEvent(&event);
     }
 
+    reportConfigureChanges();
+
+    // NOTE: Raw motion needs no re-centering, as its deltas are not limited by
+    //       the pointer reaching the edge of the window
     _GLFWwindow* window = _glfw.x11.disabledCursorWindow;
-    if (window)
+    if (window && !window->rawMouseMotion)
     {
         int width, height;
         _glfwGetWindowSizeX11(window, &width, &height);
@@ -2808,23 +3582,56 @@ void _glfwPollEventsX11(void)
 
 void _glfwWaitEventsX11(void)
 {
+    updateEventMasks();
     waitForAnyEvent(NULL);
     _glfwPollEventsX11();
 }
 
 void _glfwWaitEventsTimeoutX11(double timeout)
 {
+    updateEventMasks();
     waitForAnyEvent(&timeout);
     _glfwPollEventsX11();
 }
 
 void _glfwPostEmptyEventX11(void)
 {
-    writeEmptyEvent();
+    _glfwSignalWakePOSIX(&_glfw.x11.emptyEventWake);
+}
+
+int _glfwGetEventLoopFdX11(void)
+{
+    int fds[3];
+    int count = 0;
+
+    fds[count++] = ConnectionNumber(_glfw.x11.display);
+    fds[count++] = _glfw.x11.emptyEventWake.fds[0];
+
+#if defined(__linux__)
+    if (_glfw.joysticksInitialized)
+        fds[count++] = _glfw.linjs.inotify;
+#endif
+
+    XFlush(_glfw.x11.display);
+
+    // NOTE: Events already read into the Xlib queue, for example by a request
+    //       that waited for a reply, do not make the connection readable
+    return _glfwUpdateEventLoopPOSIX(&_glfw.x11.eventLoop, fds, count,
+                                     QLength(_glfw.x11.display) > 0);
 }
 
 void _glfwGetCursorPosX11(_GLFWwindow* window, double* xpos, double* ypos)
 {
+    if (window->x11.cursorInside && (window->x11.eventMask & PointerMotionMask))
+    {
+        if (xpos)
+            *xpos = window->x11.lastCursorPosX;
+        if (ypos)
+            *ypos = window->x11.lastCursorPosY;
+
+        return;
+    }
+
     Window root, child;
     int rootX, rootY, childX, childY;
     unsigned int mask;
@@ -2846,6 +3653,14 @@ void _glfwSetCursorPosX11(_GLFWwindow* window, double x, double y)
     window->x11.warpCursorPosX = (int) x;
     window->x11.warpCursorPosY = (int) y;
 
+    // The disabled cursor motion deltas are relative to the last received
+    // position, so only update it here when the cursor is not disabled
+    if (window->cursorMode != GLFW_CURSOR_DISABLED)
+    {
+        window->x11.lastCursorPosX = (int) x;
+        window->x11.lastCursorPosY = (int) y;
+    }
+
     XWarpPointer(_glfw.x11.display, None, window->x11.handle,
                  0,0,0,0, (int) x, (int) y);
     XFlush(_glfw.x11.display);
@@ -2863,6 +3678,7 @@ void _glfwSetCursorModeX11(_GLFWwindow* window, int mode)
     else
         updateCursorImage(window);
 
+    updateEventMask(window);
     XFlush(_glfw.x11.display);
 }
 
@@ -2914,7 +3730,7 @@ int _glfwCreateCursorX11(_GLFWcursor* cursor,
 
 int _glfwCreateStandardCursorX11(_GLFWcursor* cursor, int shape)
 {
-    if (_glfw.x11.xcursor.handle)
+    if (_glfwLoadXcursorX11())
     {
         char* theme = XcursorGetTheme(_glfw.x11.display);
         if (theme)
@@ -3103,6 +3919,9 @@ void _glfwGetRequiredInstanceExtensionsX11(char** extensions)
     if (!_glfw.vk.KHR_surface)
         return;
 
+    if (_glfw.vk.KHR_xcb_surface)
+        _glfwLoadX11XCBX11();
+
     if (!_glfw.vk.KHR_xcb_surface || !_glfw.x11.x11xcb.handle)
     {
         if (!_glfw.vk.KHR_xlib_surface)
@@ -0,0 +1,136 @@
+//========================================================================
+// Event dispatch benchmark
+// Copyright (c) Camilla Löwy <elmindreda@glfw.org>
+//
+// This software is provided 'as-is', without any express or implied
+// warranty. In no event will the authors be held liable for any damages
+// arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it
+// freely, subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented; you must not
+//    claim that you wrote the original software. If you use this software
+//    in a product, an acknowledgment in the product documentation would
+//    be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such, and must not
+//    be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source
+//    distribution.
+//
+//========================================================================
+//
+// This test measures how long it takes to process a round of events sent to
+// every one of a large number of hidden windows, which on X11 is dominated by
+// looking up the window each event is for
+//
+//========================================================================
+
+#define GLFW_INCLUDE_NONE
+#include <GLFW/glfw3.h>
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "getopt.h"
+
+static void usage(void)
+{
+    printf("Usage: dispatch [-h] [-n WINDOWS] [-r ROUNDS]\n");
+    printf("Options:\n");
+    printf("  -h show this help\n");
+    printf("  -n the number of hidden windows\n");
+    printf("  -r the number of rounds of events to process\n");
+}
+
+static void error_callback(int error, const char* description)
+{
+    fprintf(stderr, "Error: %s\n", description);
+}
+
+int main(int argc, char** argv)
+{
+    int ch, i, j, window_count = 500, round_count = 100;
+    double start, elapsed = 0.0;
+    char title[64];
+    GLFWwindow** windows;
+
+    while ((ch = getopt(argc, argv, "hn:r:")) != -1)
+    {
+        switch (ch)
+        {
+            case 'h':
+                usage();
+                exit(EXIT_SUCCESS);
+            case 'n':
+                window_count = atoi(optarg);
+                break;
+            case 'r':
+                round_count = atoi(optarg);
+                break;
+            default:
+                usage();
+                exit(EXIT_FAILURE);
+        }
+    }
+
+    if (window_count < 1 || round_count < 1)
+    {
+        usage();
+        exit(EXIT_FAILURE);
+    }
+
+    glfwSetErrorCallback(error_callback);
+
+    if (!glfwInit())
+        exit(EXIT_FAILURE);
+
+    glfwWindowHint(GLFW_VISIBLE, GLFW_FALSE);
+    glfwWindowHint(GLFW_CLIENT_API, GLFW_NO_API);
+
+    windows = calloc(window_count, sizeof(GLFWwindow*));
+
+    for (i = 0;  i < window_count;  i++)
+    {
+        windows[i] = glfwCreateWindow(64, 64, "Event Dispatch Benchmark", NULL, NULL);
+        if (!windows[i])
+        {
+            glfwTerminate();
+            exit(EXIT_FAILURE);
+        }
+    }
+
+    // Discard the events from window creation
+    glfwGetWindowAttrib(windows[0], GLFW_FOCUSED);
+    glfwPollEvents();
+
+    for (i = 0;  i < round_count;  i++)
+    {
+        // Changing the title makes the server send property change events
+        snprintf(title, sizeof(title), "Event Dispatch Benchmark %i", i);
+        for (j = 0;  j < window_count;  j++)
+            glfwSetWindowTitle(windows[j], title);
+
+        // NOTE: Querying the focus waits for a reply, which means every event
+        //       caused by the new titles has arrived before the timing starts
+        glfwGetWindowAttrib(windows[0], GLFW_FOCUSED);
+
+        start = glfwGetTime();
+        glfwPollEvents();
+        elapsed += glfwGetTime() - start;
+    }
+
+    printf("Processed %i rounds of events for %i hidden windows in %0.3f seconds\n",
+           round_count, window_count, elapsed);
+    printf("%0.3f ms per round, %0.3f us per window\n",
+           elapsed * 1000.0 / round_count,
+           elapsed * 1e6 / ((double) round_count * window_count));
+
+    free(windows);
+
+    glfwTerminate();
+    exit(EXIT_SUCCESS);
+}
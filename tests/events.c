@@ -332,9 +332,11 @@ static void window_close_callback(GLFWwindow* window)
 
 static void window_refresh_callback(GLFWwindow* window)
 {
+    int count;
     Slot* slot = glfwGetWindowUserPointer(window);
-    printf("%08x to %i at %0.3f: Window refresh\n",
-           counter++, slot->number, glfwGetTime());
+    glfwGetWindowDamage(window, &count);
+    printf("%08x to %i at %0.3f: Window refresh (%i damaged areas)\n",
+           counter++, slot->number, glfwGetTime(), count);
 
     glfwMakeContextCurrent(window);
     glClear(GL_COLOR_BUFFER_BIT);
@@ -454,6 +456,13 @@ static void char_callback(GLFWwindow* window, unsigned int codepoint)
            counter++, slot->number, glfwGetTime(), codepoint, string);
 }
 
+static void text_callback(GLFWwindow* window, const char* text)
+{
+    Slot* slot = glfwGetWindowUserPointer(window);
+    printf("%08x to %i at %0.3f: Text (%s) input\n",
+           counter++, slot->number, glfwGetTime(), text);
+}
+
 static void drop_callback(GLFWwindow* window, int count, const char* paths[])
 {
     int i;
@@ -638,6 +647,7 @@ int main(int argc, char** argv)
         glfwSetScrollCallback(slots[i].window, scroll_callback);
         glfwSetKeyCallback(slots[i].window, key_callback);
         glfwSetCharCallback(slots[i].window, char_callback);
+        glfwSetTextCallback(slots[i].window, text_callback);
         glfwSetDropCallback(slots[i].window, drop_callback);
 
         glfwMakeContextCurrent(slots[i].window);
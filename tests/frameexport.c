@@ -0,0 +1,284 @@
+//========================================================================
+// Frame export test
+// Copyright (c) Camilla Löwy <elmindreda@glfw.org>
+//
+// This software is provided 'as-is', without any express or implied
+// warranty. In no event will the authors be held liable for any damages
+// arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it
+// freely, subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented; you must not
+//    claim that you wrote the original software. If you use this software
+//    in a product, an acknowledgment in the product documentation would
+//    be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such, and must not
+//    be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source
+//    distribution.
+//
+//========================================================================
+//
+// This test reads the frames of a null platform window with a software
+// framebuffer from its frame export ring, the way another process would, and
+// checks their numbers, sizes and pixels, including across a resize of the
+// ring
+//
+//========================================================================
+
+#define GLFW_INCLUDE_NONE
+#include <GLFW/glfw3.h>
+#define GLFW_EXPOSE_NATIVE_NULL
+#include <GLFW/glfw3native.h>
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+#include "getopt.h"
+
+static void usage(void)
+{
+    printf("Usage: frameexport [-h] [-n FRAMES] [-s SLOTS]\n");
+    printf("Options:\n");
+    printf("  -h show this help\n");
+    printf("  -n the number of frames to publish\n");
+    printf("  -s the number of slots in the ring\n");
+}
+
+static void error_callback(int error, const char* description)
+{
+    fprintf(stderr, "Error: %s\n", description);
+}
+
+static unsigned char pattern(int frame, int x, int y, int channel)
+{
+    return (unsigned char) (frame * 31 + x * 7 + y * 13 + channel * 61);
+}
+
+static void draw_frame(GLFWwindow* window, int frame)
+{
+    int x, y, c, width, height, stride;
+    unsigned char* pixels = glfwGetWindowPixels(window, &stride);
+
+    glfwGetFramebufferSize(window, &width, &height);
+
+    for (y = 0;  y < height;  y++)
+    {
+        for (x = 0;  x < width;  x++)
+        {
+            for (c = 0;  c < 4;  c++)
+                pixels[y * stride + x * 4 + c] = pattern(frame, x, y, c);
+        }
+    }
+}
+
+// Maps the current size of the shared memory, as a consumer would
+static GLFWframeexport* map_export(int fd, size_t* size)
+{
+    struct stat st;
+    void* memory;
+
+    if (fstat(fd, &st) != 0)
+        return NULL;
+
+    memory = mmap(NULL, st.st_size, PROT_READ, MAP_SHARED, fd, 0);
+    if (memory == MAP_FAILED)
+        return NULL;
+
+    *size = st.st_size;
+    return memory;
+}
+
+// Reads and checks the most recent frame, following the documented protocol
+static int check_frame(int fd, GLFWframeexport** header, size_t* size,
+                       unsigned int* layout, unsigned int* sequences,
+                       int frame, int width, int height)
+{
+    const GLFWframeslot* slot;
+    const unsigned char* pixels;
+    unsigned int sequence;
+    int x, y, c;
+
+    while ((*header)->sequence != *layout)
+    {
+        if ((*header)->sequence & 1)
+            continue;
+
+        munmap(*header, *size);
+
+        *header = map_export(fd, size);
+        if (!*header)
+        {
+            fprintf(stderr, "Failed to map the frame export memory again\n");
+            return GLFW_FALSE;
+        }
+
+        *layout = (*header)->sequence;
+        printf("Mapped layout %u with %u byte slots\n",
+               *layout, (unsigned int) (*header)->slotSize);
+    }
+
+    if ((*header)->frame != (unsigned int) frame)
+    {
+        fprintf(stderr, "Frame %u published, expected %i\n",
+                (*header)->frame, frame);
+        return GLFW_FALSE;
+    }
+
+    slot = (const GLFWframeslot*) ((const unsigned char*) *header +
+                                   (*header)->slotOffset +
+                                   (*header)->slotSize * (frame % (*header)->slotCount));
+
+    sequence = slot->sequence;
+    if (sequence & 1)
+    {
+        fprintf(stderr, "Slot of frame %i is still being written\n", frame);
+        return GLFW_FALSE;
+    }
+
+    // A reader that only checks the slot must never see a sequence number again
+    if (sequence <= sequences[frame % (*header)->slotCount])
+    {
+        fprintf(stderr, "Slot of frame %i reused sequence number %u\n",
+                frame, sequence);
+        return GLFW_FALSE;
+    }
+
+    sequences[frame % (*header)->slotCount] = sequence;
+
+    if (slot->frame != (unsigned int) frame ||
+        slot->width != (unsigned int) width ||
+        slot->height != (unsigned int) height)
+    {
+        fprintf(stderr, "Slot holds frame %u of %ux%u, expected frame %i of %ix%i\n",
+                slot->frame, slot->width, slot->height, frame, width, height);
+        return GLFW_FALSE;
+    }
+
+    pixels = (const unsigned char*) slot + slot->offset;
+
+    for (y = 0;  y < height;  y++)
+    {
+        for (x = 0;  x < width;  x++)
+        {
+            for (c = 0;  c < 4;  c++)
+            {
+                if (pixels[y * slot->stride + x * 4 + c] != pattern(frame, x, y, c))
+                {
+                    fprintf(stderr, "Frame %i differs at %i,%i\n", frame, x, y);
+                    return GLFW_FALSE;
+                }
+            }
+        }
+    }
+
+    if (slot->sequence != sequence || (*header)->sequence != *layout)
+    {
+        fprintf(stderr, "Frame %i changed while it was read\n", frame);
+        return GLFW_FALSE;
+    }
+
+    return GLFW_TRUE;
+}
+
+int main(int argc, char** argv)
+{
+    int ch, i, fd, width = 64, height = 48, frame_count = 10, slot_count = 3;
+    unsigned int layout;
+    unsigned int* sequences;
+    size_t size;
+    GLFWwindow* window;
+    GLFWframeexport* header;
+
+    while ((ch = getopt(argc, argv, "hn:s:")) != -1)
+    {
+        switch (ch)
+        {
+            case 'h':
+                usage();
+                exit(EXIT_SUCCESS);
+            case 'n':
+                frame_count = atoi(optarg);
+                break;
+            case 's':
+                slot_count = atoi(optarg);
+                break;
+            default:
+                usage();
+                exit(EXIT_FAILURE);
+        }
+    }
+
+    if (frame_count < 1 || slot_count < 1)
+    {
+        usage();
+        exit(EXIT_FAILURE);
+    }
+
+    glfwSetErrorCallback(error_callback);
+
+    glfwInitHint(GLFW_PLATFORM, GLFW_PLATFORM_NULL);
+
+    if (!glfwInit())
+        exit(EXIT_FAILURE);
+
+    glfwWindowHint(GLFW_CLIENT_API, GLFW_NO_API);
+    glfwWindowHint(GLFW_SOFTWARE_FRAMEBUFFER, GLFW_TRUE);
+    glfwWindowHint(GLFW_NULL_FRAME_EXPORT, slot_count);
+
+    window = glfwCreateWindow(width, height, "Frame Export Test", NULL, NULL);
+    if (!window)
+    {
+        glfwTerminate();
+        exit(EXIT_FAILURE);
+    }
+
+    fd = glfwGetNullFrameExportFd(window);
+
+    header = map_export(fd, &size);
+    if (!header || header->magic != GLFW_FRAME_EXPORT_MAGIC)
+    {
+        fprintf(stderr, "Failed to map the frame export memory\n");
+        glfwTerminate();
+        exit(EXIT_FAILURE);
+    }
+
+    layout = header->sequence;
+    sequences = calloc(slot_count, sizeof(unsigned int));
+
+    for (i = 1;  i <= frame_count;  i++)
+    {
+        // Grow the window halfway through so the ring has to be resized
+        if (i == frame_count / 2 + 1)
+        {
+            width *= 2;
+            height *= 2;
+            glfwSetWindowSize(window, width, height);
+        }
+
+        draw_frame(window, i);
+        glfwSwapBuffers(window);
+
+        if (!check_frame(fd, &header, &size, &layout, sequences,
+                         i, width, height))
+        {
+            glfwTerminate();
+            exit(EXIT_FAILURE);
+        }
+    }
+
+    printf("Read %i frames through a ring of %i slots\n", frame_count, slot_count);
+
+    free(sequences);
+    munmap(header, size);
+
+    glfwTerminate();
+    exit(EXIT_SUCCESS);
+}
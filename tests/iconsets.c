@@ -0,0 +1,175 @@
+//========================================================================
+// Icon and cursor upload benchmark
+// Copyright (c) Camilla Löwy <elmindreda@glfw.org>
+//
+// This software is provided 'as-is', without any express or implied
+// warranty. In no event will the authors be held liable for any damages
+// arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it
+// freely, subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented; you must not
+//    claim that you wrote the original software. If you use this software
+//    in a product, an acknowledgment in the product documentation would
+//    be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such, and must not
+//    be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source
+//    distribution.
+//
+//========================================================================
+//
+// This test measures how long it takes to set a large window icon set and to
+// create cursors from large images, which is dominated by pixel conversion,
+// and how long it takes to set an icon set that has already been converted
+//
+//========================================================================
+
+#define GLFW_INCLUDE_NONE
+#include <GLFW/glfw3.h>
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "getopt.h"
+
+static void usage(void)
+{
+    printf("Usage: iconsets [-h] [-n IMAGES] [-s SIZE] [-r REPEATS]\n");
+    printf("Options:\n");
+    printf("  -h show this help\n");
+    printf("  -n the number of images in the icon set\n");
+    printf("  -s the width and height of each image\n");
+    printf("  -r the number of times to set the icon set\n");
+}
+
+static void error_callback(int error, const char* description)
+{
+    fprintf(stderr, "Error: %s\n", description);
+}
+
+int main(int argc, char** argv)
+{
+    int ch, i, j, image_count = 8, size = 256, repeat_count = 100;
+    double start, elapsed;
+    unsigned char* pixels;
+    GLFWimage* images;
+    GLFWwindow* window;
+
+    while ((ch = getopt(argc, argv, "hn:s:r:")) != -1)
+    {
+        switch (ch)
+        {
+            case 'h':
+                usage();
+                exit(EXIT_SUCCESS);
+            case 'n':
+                image_count = atoi(optarg);
+                break;
+            case 's':
+                size = atoi(optarg);
+                break;
+            case 'r':
+                repeat_count = atoi(optarg);
+                break;
+            default:
+                usage();
+                exit(EXIT_FAILURE);
+        }
+    }
+
+    if (image_count < 1 || size < 1 || repeat_count < 1)
+    {
+        usage();
+        exit(EXIT_FAILURE);
+    }
+
+    glfwSetErrorCallback(error_callback);
+
+    if (!glfwInit())
+        exit(EXIT_FAILURE);
+
+    glfwWindowHint(GLFW_VISIBLE, GLFW_FALSE);
+    glfwWindowHint(GLFW_CLIENT_API, GLFW_NO_API);
+
+    window = glfwCreateWindow(640, 480, "Icon Set Benchmark", NULL, NULL);
+    if (!window)
+    {
+        glfwTerminate();
+        exit(EXIT_FAILURE);
+    }
+
+    // Translucent gradients so premultiplication has work to do
+    pixels = malloc((size_t) size * size * 4);
+    for (i = 0;  i < size * size;  i++)
+    {
+        pixels[i * 4 + 0] = (unsigned char) (i % size);
+        pixels[i * 4 + 1] = (unsigned char) (i / size);
+        pixels[i * 4 + 2] = (unsigned char) i;
+        pixels[i * 4 + 3] = (unsigned char) (i * 7);
+    }
+
+    images = calloc(image_count, sizeof(GLFWimage));
+    for (i = 0;  i < image_count;  i++)
+    {
+        images[i].width = size;
+        images[i].height = size;
+        images[i].pixels = pixels;
+    }
+
+    start = glfwGetTime();
+
+    for (i = 0;  i < repeat_count;  i++)
+    {
+        // Change a pixel so every icon set is new and has to be converted
+        pixels[3] = (unsigned char) i;
+        glfwSetWindowIcon(window, image_count, images);
+    }
+
+    elapsed = glfwGetTime() - start;
+
+    printf("Set %i icon sets of %i %ix%i images in %0.3f seconds\n",
+           repeat_count, image_count, size, size, elapsed);
+    printf("%0.3f ms per icon set, %0.1f megapixels per second\n",
+           elapsed * 1000.0 / repeat_count,
+           (double) size * size * image_count * repeat_count / elapsed / 1e6);
+
+    start = glfwGetTime();
+
+    for (i = 0;  i < repeat_count;  i++)
+        glfwSetWindowIcon(window, image_count, images);
+
+    elapsed = glfwGetTime() - start;
+
+    printf("Set the same icon set %i times in %0.3f seconds\n",
+           repeat_count, elapsed);
+    printf("%0.3f ms per unchanged icon set\n", elapsed * 1000.0 / repeat_count);
+
+    start = glfwGetTime();
+
+    for (i = 0;  i < repeat_count;  i++)
+    {
+        for (j = 0;  j < image_count;  j++)
+        {
+            GLFWcursor* cursor = glfwCreateCursor(images + j, 0, 0);
+            glfwDestroyCursor(cursor);
+        }
+    }
+
+    elapsed = glfwGetTime() - start;
+
+    printf("Created %i %ix%i cursors in %0.3f seconds\n",
+           repeat_count * image_count, size, size, elapsed);
+    printf("%0.3f ms per cursor\n",
+           elapsed * 1000.0 / (repeat_count * image_count));
+
+    free(images);
+    free(pixels);
+
+    glfwTerminate();
+    exit(EXIT_SUCCESS);
+}
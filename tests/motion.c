@@ -0,0 +1,177 @@
+//========================================================================
+// Motion event flood benchmark
+// Copyright (c) Camilla Löwy <elmindreda@glfw.org>
+//
+// This software is provided 'as-is', without any express or implied
+// warranty. In no event will the authors be held liable for any damages
+// arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it
+// freely, subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented; you must not
+//    claim that you wrote the original software. If you use this software
+//    in a product, an acknowledgment in the product documentation would
+//    be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such, and must not
+//    be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source
+//    distribution.
+//
+//========================================================================
+//
+// This test floods a hidden window with queued X11 motion events and measures
+// how many cursor position events are reported and how much time is spent
+// processing them per frame, with and without motion compression
+//
+//========================================================================
+
+#define GLFW_INCLUDE_NONE
+#include <GLFW/glfw3.h>
+#define GLFW_EXPOSE_NATIVE_X11
+#include <GLFW/glfw3native.h>
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+#include "getopt.h"
+
+static unsigned long cursor_pos_count = 0;
+
+static void usage(void)
+{
+    printf("Usage: motion [-h] [-n EVENTS] [-f FRAMES]\n");
+    printf("Options:\n");
+    printf("  -h show this help\n");
+    printf("  -n the number of motion events sent per frame\n");
+    printf("  -f the number of frames\n");
+}
+
+static void error_callback(int error, const char* description)
+{
+    fprintf(stderr, "Error: %s\n", description);
+}
+
+static void cursor_position_callback(GLFWwindow* window, double x, double y)
+{
+    cursor_pos_count++;
+}
+
+static int run_benchmark(int compression, int event_count, int frame_count)
+{
+    int i, j;
+    double start, elapsed = 0.0;
+    clock_t cpu_start, cpu_elapsed = 0;
+    Display* display;
+    Window handle;
+    GLFWwindow* window;
+
+    glfwInitHint(GLFW_PLATFORM, GLFW_PLATFORM_X11);
+    glfwInitHint(GLFW_X11_MOTION_COMPRESSION, compression);
+
+    if (!glfwInit())
+        return GLFW_FALSE;
+
+    glfwWindowHint(GLFW_VISIBLE, GLFW_FALSE);
+    glfwWindowHint(GLFW_CLIENT_API, GLFW_NO_API);
+
+    window = glfwCreateWindow(640, 480, "Motion Flood Benchmark", NULL, NULL);
+    if (!window)
+    {
+        glfwTerminate();
+        return GLFW_FALSE;
+    }
+
+    glfwSetCursorPosCallback(window, cursor_position_callback);
+
+    display = glfwGetX11Display();
+    handle = glfwGetX11Window(window);
+
+    // Discard the events from window creation
+    XSync(display, False);
+    glfwPollEvents();
+
+    cursor_pos_count = 0;
+
+    for (i = 0;  i < frame_count;  i++)
+    {
+        for (j = 0;  j < event_count;  j++)
+        {
+            XEvent event = { MotionNotify };
+            event.xmotion.display = display;
+            event.xmotion.window = handle;
+            event.xmotion.x = 1 + j % 600;
+            event.xmotion.y = 1 + i % 400;
+            event.xmotion.same_screen = True;
+
+            // An empty event mask sends the event to the client that created
+            // the window, which is this one
+            XSendEvent(display, handle, False, 0, &event);
+        }
+
+        // NOTE: Every event sent has been read into the queue once this returns
+        XSync(display, False);
+
+        start = glfwGetTime();
+        cpu_start = clock();
+
+        glfwPollEvents();
+
+        cpu_elapsed += clock() - cpu_start;
+        elapsed += glfwGetTime() - start;
+    }
+
+    printf("Motion compression %s:\n", compression ? "on" : "off");
+    printf("  %0.1f of %i motion events reported per frame\n",
+           (double) cursor_pos_count / frame_count, event_count);
+    printf("  %0.3f ms and %0.3f ms of CPU time per frame\n",
+           elapsed * 1000.0 / frame_count,
+           (double) cpu_elapsed * 1000.0 / CLOCKS_PER_SEC / frame_count);
+
+    glfwTerminate();
+    return GLFW_TRUE;
+}
+
+int main(int argc, char** argv)
+{
+    int ch, event_count = 1000, frame_count = 100;
+
+    while ((ch = getopt(argc, argv, "hn:f:")) != -1)
+    {
+        switch (ch)
+        {
+            case 'h':
+                usage();
+                exit(EXIT_SUCCESS);
+            case 'n':
+                event_count = atoi(optarg);
+                break;
+            case 'f':
+                frame_count = atoi(optarg);
+                break;
+            default:
+                usage();
+                exit(EXIT_FAILURE);
+        }
+    }
+
+    if (event_count < 1 || frame_count < 1)
+    {
+        usage();
+        exit(EXIT_FAILURE);
+    }
+
+    glfwSetErrorCallback(error_callback);
+
+    if (!run_benchmark(GLFW_FALSE, event_count, frame_count))
+        exit(EXIT_FAILURE);
+
+    if (!run_benchmark(GLFW_TRUE, event_count, frame_count))
+        exit(EXIT_FAILURE);
+
+    exit(EXIT_SUCCESS);
+}
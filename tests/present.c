@@ -0,0 +1,248 @@
+//========================================================================
+// Pixel presentation test
+// Copyright (c) Camilla Löwy <elmindreda@glfw.org>
+//
+// This software is provided 'as-is', without any express or implied
+// warranty. In no event will the authors be held liable for any damages
+// arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it
+// freely, subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented; you must not
+//    claim that you wrote the original software. If you use this software
+//    in a product, an acknowledgment in the product documentation would
+//    be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such, and must not
+//    be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source
+//    distribution.
+//
+//========================================================================
+//
+// This test presents a full frame and then a frame limited to a damage
+// rectangle with glfwPresentPixels, reads the window contents back from the
+// X server and checks them, once with MIT-SHM and once with XPutImage
+//
+// It is meant to be run under Xvfb, where nothing covers the window
+//
+//========================================================================
+
+#define GLFW_INCLUDE_NONE
+#include <GLFW/glfw3.h>
+#define GLFW_EXPOSE_NATIVE_X11
+#include <GLFW/glfw3native.h>
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "getopt.h"
+
+static void usage(void)
+{
+    printf("Usage: present [-h] [-s SIZE]\n");
+    printf("Options:\n");
+    printf("  -h show this help\n");
+    printf("  -s the width and height of the window\n");
+}
+
+static void error_callback(int error, const char* description)
+{
+    fprintf(stderr, "Error: %s\n", description);
+}
+
+static void fill_frame(unsigned char* pixels, int size, int frame)
+{
+    int x, y;
+
+    for (y = 0;  y < size;  y++)
+    {
+        for (x = 0;  x < size;  x++)
+        {
+            unsigned char* p = pixels + (y * size + x) * 4;
+            p[0] = (unsigned char) (x * 3 + frame * 101);
+            p[1] = (unsigned char) (y * 5 + frame * 37);
+            p[2] = (unsigned char) ((x ^ y) + frame * 59);
+            p[3] = 255;
+        }
+    }
+}
+
+static int mask_shift(unsigned long mask)
+{
+    int shift = 0;
+
+    while (mask && !(mask & 1))
+    {
+        mask >>= 1;
+        shift++;
+    }
+
+    return shift;
+}
+
+// Reads back the window and checks every pixel against the expected frames
+static int check_window(GLFWwindow* window, int size,
+                        const unsigned char* first, const unsigned char* second,
+                        const GLFWrect* rect)
+{
+    int x, y, result = GLFW_TRUE;
+    Display* display = glfwGetX11Display();
+    XImage* image;
+
+    XSync(display, False);
+
+    image = XGetImage(display, glfwGetX11Window(window),
+                      0, 0, size, size, AllPlanes, ZPixmap);
+    if (!image)
+    {
+        fprintf(stderr, "Failed to read back the window contents\n");
+        return GLFW_FALSE;
+    }
+
+    for (y = 0;  y < size && result;  y++)
+    {
+        for (x = 0;  x < size;  x++)
+        {
+            const unsigned long pixel = XGetPixel(image, x, y);
+            const unsigned char* expected = first;
+
+            if (second &&
+                x >= rect->x && x < rect->x + rect->width &&
+                y >= rect->y && y < rect->y + rect->height)
+            {
+                expected = second;
+            }
+
+            expected += (y * size + x) * 4;
+
+            if (((pixel & image->red_mask) >> mask_shift(image->red_mask)) != expected[0] ||
+                ((pixel & image->green_mask) >> mask_shift(image->green_mask)) != expected[1] ||
+                ((pixel & image->blue_mask) >> mask_shift(image->blue_mask)) != expected[2])
+            {
+                fprintf(stderr, "Pixel at %i,%i is 0x%06lx, expected %u,%u,%u\n",
+                        x, y, pixel, expected[0], expected[1], expected[2]);
+                result = GLFW_FALSE;
+                break;
+            }
+        }
+    }
+
+    XDestroyImage(image);
+    return result;
+}
+
+static int run_test(int shared, int size,
+                    unsigned char* first, unsigned char* second)
+{
+    int opcode, event, error;
+    const GLFWrect rect = { size / 8, size / 4, size / 2, size / 3 };
+    GLFWwindow* window;
+
+    glfwInitHint(GLFW_PLATFORM, GLFW_PLATFORM_X11);
+    glfwInitHint(GLFW_X11_SHARED_MEMORY, shared);
+
+    if (!glfwInit())
+        return GLFW_FALSE;
+
+    glfwWindowHint(GLFW_CLIENT_API, GLFW_NO_API);
+    glfwWindowHint(GLFW_RESIZABLE, GLFW_FALSE);
+
+    window = glfwCreateWindow(size, size, "Pixel Presentation Test", NULL, NULL);
+    if (!window)
+    {
+        glfwTerminate();
+        return GLFW_FALSE;
+    }
+
+    if (shared && !XQueryExtension(glfwGetX11Display(), "MIT-SHM",
+                                   &opcode, &event, &error))
+    {
+        printf("MIT-SHM is not available, testing XPutImage instead\n");
+    }
+
+    glfwPollEvents();
+
+    fill_frame(first, size, 0);
+    glfwPresentPixels(window, first, size * 4, NULL);
+
+    if (!check_window(window, size, first, NULL, NULL))
+    {
+        glfwTerminate();
+        return GLFW_FALSE;
+    }
+
+    fill_frame(second, size, 1);
+    glfwPresentPixels(window, second, size * 4, &rect);
+
+    if (!check_window(window, size, first, second, &rect))
+    {
+        glfwTerminate();
+        return GLFW_FALSE;
+    }
+
+    // Present a second full frame so both shared memory images have been used
+    fill_frame(first, size, 2);
+    glfwPresentPixels(window, first, size * 4, NULL);
+
+    if (!check_window(window, size, first, NULL, NULL))
+    {
+        glfwTerminate();
+        return GLFW_FALSE;
+    }
+
+    printf("%s: full and damage rectangle frames match\n",
+           shared ? "MIT-SHM" : "XPutImage");
+
+    glfwTerminate();
+    return GLFW_TRUE;
+}
+
+int main(int argc, char** argv)
+{
+    int ch, size = 256;
+    unsigned char* first;
+    unsigned char* second;
+
+    while ((ch = getopt(argc, argv, "hs:")) != -1)
+    {
+        switch (ch)
+        {
+            case 'h':
+                usage();
+                exit(EXIT_SUCCESS);
+            case 's':
+                size = atoi(optarg);
+                break;
+            default:
+                usage();
+                exit(EXIT_FAILURE);
+        }
+    }
+
+    if (size < 8)
+    {
+        usage();
+        exit(EXIT_FAILURE);
+    }
+
+    glfwSetErrorCallback(error_callback);
+
+    first = malloc((size_t) size * size * 4);
+    second = malloc((size_t) size * size * 4);
+
+    if (!run_test(GLFW_TRUE, size, first, second) ||
+        !run_test(GLFW_FALSE, size, first, second))
+    {
+        free(first);
+        free(second);
+        exit(EXIT_FAILURE);
+    }
+
+    free(first);
+    free(second);
+    exit(EXIT_SUCCESS);
+}
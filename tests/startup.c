@@ -0,0 +1,152 @@
+//========================================================================
+// Library initialization benchmark
+// Copyright (c) Camilla Löwy <elmindreda@glfw.org>
+//
+// This software is provided 'as-is', without any express or implied
+// warranty. In no event will the authors be held liable for any damages
+// arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it
+// freely, subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented; you must not
+//    claim that you wrote the original software. If you use this software
+//    in a product, an acknowledgment in the product documentation would
+//    be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such, and must not
+//    be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source
+//    distribution.
+//
+//========================================================================
+//
+// This test measures how long it takes to initialize and terminate the library,
+// which on X11 is dominated by round trips to the server and loading modules
+//
+//========================================================================
+
+#include "tinycthread.h"
+
+#define GLFW_INCLUDE_NONE
+#include <GLFW/glfw3.h>
+
+#if USE_NATIVE_X11
+ #define GLFW_EXPOSE_NATIVE_X11
+ #include <GLFW/glfw3native.h>
+#endif
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "getopt.h"
+
+static void usage(void)
+{
+    printf("Usage: startup [-h] [-n RUNS]\n");
+    printf("Options:\n");
+    printf("  -h show this help\n");
+    printf("  -n the number of times to initialize and terminate GLFW\n");
+}
+
+static void error_callback(int error, const char* description)
+{
+    fprintf(stderr, "Error: %s\n", description);
+}
+
+// The GLFW timer is only available while the library is initialized
+static double get_seconds(void)
+{
+    struct timespec ts;
+    timespec_get(&ts, TIME_UTC);
+    return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+int main(int argc, char** argv)
+{
+    int ch, i, j, run_count = 20;
+    double start, init_time = 0.0, terminate_time = 0.0;
+    double fastest = 0.0, slowest = 0.0;
+    unsigned long request_count = 0;
+
+    while ((ch = getopt(argc, argv, "hn:")) != -1)
+    {
+        switch (ch)
+        {
+            case 'h':
+                usage();
+                exit(EXIT_SUCCESS);
+            case 'n':
+                run_count = atoi(optarg);
+                break;
+            default:
+                usage();
+                exit(EXIT_FAILURE);
+        }
+    }
+
+    if (run_count < 1)
+    {
+        usage();
+        exit(EXIT_FAILURE);
+    }
+
+    glfwSetErrorCallback(error_callback);
+
+    for (i = 0;  i < run_count;  i++)
+    {
+        double elapsed;
+
+        start = get_seconds();
+
+        if (!glfwInit())
+            exit(EXIT_FAILURE);
+
+        elapsed = get_seconds() - start;
+        init_time += elapsed;
+
+        if (i == 0 || elapsed < fastest)
+            fastest = elapsed;
+        if (i == 0 || elapsed > slowest)
+            slowest = elapsed;
+
+#if USE_NATIVE_X11
+        // NOTE: The connection is opened by glfwInit, so the sequence number of
+        //       the next request is one more than the number of requests it sent
+        if (glfwGetPlatform() == GLFW_PLATFORM_X11)
+            request_count += XNextRequest(glfwGetX11Display()) - 1;
+#endif
+
+        if (i == run_count - 1)
+        {
+            int module_count;
+            const GLFWmoduletime* modules = glfwGetModuleLoadTimes(&module_count);
+
+            for (j = 0;  j < module_count;  j++)
+            {
+                printf("Module %s loaded in %0.3f ms\n",
+                       modules[j].name, modules[j].seconds * 1000.0);
+            }
+        }
+
+        start = get_seconds();
+        glfwTerminate();
+        terminate_time += get_seconds() - start;
+    }
+
+    printf("Initialized and terminated GLFW %i times\n", run_count);
+    printf("glfwInit: %0.3f ms average, %0.3f ms fastest, %0.3f ms slowest\n",
+           init_time * 1000.0 / run_count, fastest * 1000.0, slowest * 1000.0);
+    printf("glfwTerminate: %0.3f ms average\n",
+           terminate_time * 1000.0 / run_count);
+
+    if (request_count)
+    {
+        printf("glfwInit: %0.1f X11 requests average\n",
+               (double) request_count / run_count);
+    }
+
+    exit(EXIT_SUCCESS);
+}
@@ -24,7 +24,8 @@
 //========================================================================
 //
 // This test is intended to verify whether the OpenGL context part of
-// the GLFW API is able to be used from multiple threads
+// the GLFW API is able to be used from multiple threads, and whether user
+// events posted from multiple threads all arrive in order
 //
 //========================================================================
 
@@ -45,6 +46,8 @@ typedef struct
     const char* title;
     float r, g, b;
     thrd_t id;
+    int posted;
+    int received;
 } Thread;
 
 static volatile int running = GLFW_TRUE;
@@ -60,9 +63,23 @@ static void key_callback(GLFWwindow* window, int key, int scancode, int action,
         glfwSetWindowShouldClose(window, GLFW_TRUE);
 }
 
+static void user_event_callback(void* payload, int tag)
+{
+    Thread* thread = payload;
+
+    if (tag != thread->received)
+    {
+        fprintf(stderr, "%s thread event %i arrived when expecting %i\n",
+                thread->title, tag, thread->received);
+    }
+
+    thread->received = tag + 1;
+}
+
 static int thread_main(void* data)
 {
-    const Thread* thread = data;
+    Thread* thread = data;
+    int i;
 
     glfwMakeContextCurrent(thread->window);
     glfwSwapInterval(1);
@@ -74,6 +91,15 @@ static int thread_main(void* data)
 
         glClear(GL_COLOR_BUFFER_BIT);
         glfwSwapBuffers(thread->window);
+
+        // Flood the user event queue alongside the other threads
+        for (i = 0;  i < 256;  i++)
+        {
+            if (!glfwPostUserEvent(thread, thread->posted))
+                break;
+
+            thread->posted++;
+        }
     }
 
     glfwMakeContextCurrent(NULL);
@@ -96,6 +122,8 @@ int main(void)
     if (!glfwInit())
         exit(EXIT_FAILURE);
 
+    glfwSetUserEventCallback(user_event_callback);
+
     glfwWindowHint(GLFW_VISIBLE, GLFW_FALSE);
 
     for (i = 0;  i < count;  i++)
@@ -148,6 +176,15 @@ int main(void)
     for (i = 0;  i < count;  i++)
         thrd_join(threads[i].id, &result);
 
+    // Deliver any user events still in the queue
+    glfwPollEvents();
+
+    for (i = 0;  i < count;  i++)
+    {
+        printf("%s thread posted %i user events and %i were received\n",
+               threads[i].title, threads[i].posted, threads[i].received);
+    }
+
     exit(EXIT_SUCCESS);
 }
 
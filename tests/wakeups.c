@@ -0,0 +1,154 @@
+//========================================================================
+// Empty event wakeup benchmark
+// Copyright (c) Camilla Löwy <elmindreda@glfw.org>
+//
+// This software is provided 'as-is', without any express or implied
+// warranty. In no event will the authors be held liable for any damages
+// arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it
+// freely, subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented; you must not
+//    claim that you wrote the original software. If you use this software
+//    in a product, an acknowledgment in the product documentation would
+//    be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such, and must not
+//    be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source
+//    distribution.
+//
+//========================================================================
+//
+// This test measures how well the main thread keeps up when several threads
+// post empty events as fast as they can
+//
+//========================================================================
+
+#include "tinycthread.h"
+
+#define GLFW_INCLUDE_NONE
+#include <GLFW/glfw3.h>
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "getopt.h"
+
+static mtx_t mutex;
+static int finished = 0;
+static int post_count = 100000;
+
+static void usage(void)
+{
+    printf("Usage: wakeups [-h] [-t THREADS] [-n POSTS]\n");
+    printf("Options:\n");
+    printf("  -h show this help\n");
+    printf("  -t the number of producer threads\n");
+    printf("  -n the number of empty events posted by each thread\n");
+}
+
+static void error_callback(int error, const char* description)
+{
+    fprintf(stderr, "Error: %s\n", description);
+}
+
+static int thread_main(void* data)
+{
+    int i;
+
+    for (i = 0;  i < post_count;  i++)
+        glfwPostEmptyEvent();
+
+    mtx_lock(&mutex);
+    finished++;
+    mtx_unlock(&mutex);
+
+    // Make sure the main thread notices that this thread is done
+    glfwPostEmptyEvent();
+    return 0;
+}
+
+int main(int argc, char** argv)
+{
+    int ch, i, done = 0, thread_count = 4;
+    unsigned long wakeups = 0;
+    double start, elapsed;
+    thrd_t* threads;
+
+    while ((ch = getopt(argc, argv, "ht:n:")) != -1)
+    {
+        switch (ch)
+        {
+            case 'h':
+                usage();
+                exit(EXIT_SUCCESS);
+            case 't':
+                thread_count = atoi(optarg);
+                break;
+            case 'n':
+                post_count = atoi(optarg);
+                break;
+            default:
+                usage();
+                exit(EXIT_FAILURE);
+        }
+    }
+
+    if (thread_count < 1 || post_count < 1)
+    {
+        usage();
+        exit(EXIT_FAILURE);
+    }
+
+    glfwSetErrorCallback(error_callback);
+
+    if (!glfwInit())
+        exit(EXIT_FAILURE);
+
+    mtx_init(&mutex, mtx_plain);
+
+    threads = calloc(thread_count, sizeof(thrd_t));
+    start = glfwGetTime();
+
+    for (i = 0;  i < thread_count;  i++)
+    {
+        if (thrd_create(threads + i, thread_main, NULL) != thrd_success)
+        {
+            fprintf(stderr, "Failed to create producer thread\n");
+
+            glfwTerminate();
+            exit(EXIT_FAILURE);
+        }
+    }
+
+    while (!done)
+    {
+        glfwWaitEvents();
+        wakeups++;
+
+        mtx_lock(&mutex);
+        done = finished == thread_count;
+        mtx_unlock(&mutex);
+    }
+
+    elapsed = glfwGetTime() - start;
+
+    for (i = 0;  i < thread_count;  i++)
+        thrd_join(threads[i], NULL);
+
+    printf("%i threads posted %i empty events each in %0.3f seconds\n",
+           thread_count, post_count, elapsed);
+    printf("%0.0f posts per second, %lu wakeups of the main thread\n",
+           thread_count * (double) post_count / elapsed, wakeups);
+
+    free(threads);
+    mtx_destroy(&mutex);
+
+    glfwTerminate();
+    exit(EXIT_SUCCESS);
+}
+